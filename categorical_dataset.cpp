@@ -0,0 +1,287 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "includes/categorical_dataset.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+bool parse_code(const std::string & cell, uint32_t & code)
+{
+
+  /* Parses a cell holding a non-negative integer below UINT32_MAX - 1, such as 3 or 3.0, so the cell's code, the integer + 1, fits an open table key. */
+
+  char * end = nullptr;
+  double value = strtod(cell.c_str(), &end);
+
+  if(end == cell.c_str() || end[strspn(end, " \t\r")] != '\0' || !(value >= 0) || value >= UINT32_MAX - 1 || floor(value) != value)
+  {
+    return false;
+  }
+
+  code = (uint32_t) value;
+  return true;
+}
+
+void set_codes(coded_column & column, const std::vector<uint32_t> & codes)
+{
+
+  /* Stores codes in the narrowest unsigned width that holds the largest of them. */
+
+  column.max_code = codes.empty() ? 0 : *std::max_element(codes.begin(), codes.end());
+  column.bytes = column.max_code <= UINT8_MAX ? 1 : (column.max_code <= UINT16_MAX ? 2 : 4);
+
+  column.codes8.clear();
+  column.codes16.clear();
+  column.codes32.clear();
+
+  if(column.bytes == 1)
+  {
+    column.codes8.assign(codes.begin(), codes.end());
+  } else if(column.bytes == 2)
+  {
+    column.codes16.assign(codes.begin(), codes.end());
+  } else
+  {
+    column.codes32.assign(codes.begin(), codes.end());
+  }
+}
+
+size_t coded_bytes(const coded_dataset & dataset)
+{
+
+  /* Returns the bytes held by the codes of every column. */
+
+  size_t bytes = 0;
+
+  for(auto & column : dataset.columns)
+  {
+    bytes += (size_t) column.bytes * dataset.rows;
+  }
+
+  return bytes;
+}
+
+const size_t dense_table_limit = 1 << 20; // entries of the largest (codes x classes) table kept dense, larger ones are hashed
+
+uint32_t hash_code(const std::string & cell, uint32_t buckets)
+{
+
+  /* Hashes the trimmed text of a cell into a code 1 .. buckets with 32 bit FNV-1a, which is stable across runs so saved models keep their buckets. */
+
+  size_t first = cell.find_first_not_of(" \t\r\n\"");
+  size_t last = cell.find_last_not_of(" \t\r\n\"");
+
+  uint32_t hash = 2166136261u;
+  for(size_t i = first; first != std::string::npos && i <= last; i++)
+  {
+    hash = (hash ^ (unsigned char) cell[i]) * 16777619u;
+  }
+
+  return 1 + hash % buckets;
+}
+
+uint32_t bin_code(const std::string & cell, const std::vector<double> & edges)
+{
+
+  /* Returns 1 + the bin of the number in cell, where bin b holds values from edges[b - 1] up to (not including) edges[b]. A cell that is not a number, or is missing, gets code 0. */
+
+  char * end = nullptr;
+  double value = strtod(cell.c_str(), &end);
+
+  if(end == cell.c_str() || end[strspn(end, " \t\r")] != '\0' || value != value)
+  {
+    return 0;
+  }
+
+  return 1 + (std::upper_bound(edges.begin(), edges.end(), value) - edges.begin());
+}
+
+coded_categorical_model fit_coded_categorical(const coded_dataset & dataset, int classes, double alpha)
+{
+
+  /* Fits Categorical NB directly on the codes, one column at a time. Like the engine's categorical distribution, the K codes 1 .. the largest code seen in a class are smoothed with (count + alpha) / (n + alpha * K), where n leaves out the rows missing the column (code 0), and any other code has probability 0. Columns with many distinct codes count them in open addressing tables, so memory grows with the codes actually seen rather than the largest code. */
+
+  coded_categorical_model model;
+  model.classes = classes;
+
+  // weights are rescaled to average 1 over the rows of positive weight, as in the engine, so smoothing does not depend on their scale
+
+  double scale = 1.0;
+  if(!dataset.weights.empty())
+  {
+    double sum = 0.0;
+    int kept = 0;
+    for(auto w : dataset.weights)
+    {
+      if(w > 0)
+      {
+        sum += w;
+        kept++;
+      }
+    }
+    scale = sum > 0 ? kept / sum : 1.0;
+  }
+
+  auto weight = [&dataset, scale](int r) { return dataset.weights.empty() ? 1.0 : dataset.weights[r] * scale; };
+
+  std::vector<double> class_counts(classes, 0.0);
+  double total = 0.0;
+  for(int r = 0; r < dataset.rows; r++)
+  {
+    class_counts[dataset.classifications[r]] += weight(r);
+    total += weight(r);
+  }
+
+  for(int y = 0; y < classes; y++)
+  {
+    model.log_priors.push_back(log(class_counts[y] / total));
+  }
+
+  for(auto & column : dataset.columns)
+  {
+    coded_feature feature;
+    feature.cardinality = column.max_code;
+    feature.max_codes.assign(classes, 0);
+    feature.unseen.assign(classes, 0.0);
+
+    bool dense = (size_t) (feature.cardinality + 1) * classes <= dense_table_limit;
+
+    if(dense)
+    {
+      feature.dense.assign((size_t) (feature.cardinality + 1) * classes, 0.0);
+    } else
+    {
+      feature.sparse.resize(classes);
+    }
+
+    // rows missing this column are left out of its counts, as the engine marginalises a missing value
+
+    std::vector<double> missing(classes, 0.0);
+
+    visit_codes(column, [&](const auto * codes)
+    {
+      for(int r = 0; r < dataset.rows; r++)
+      {
+        int y = dataset.classifications[r];
+        double w = weight(r);
+        if(!(w > 0))
+        {
+          continue;
+        }
+        if(codes[r] == 0)
+        {
+          missing[y] += w;
+        } else if(dense)
+        {
+          feature.dense[(size_t) codes[r] * classes + y] += w;
+        } else
+        {
+          feature.sparse[y][codes[r]] += w;
+        }
+        feature.max_codes[y] = std::max(feature.max_codes[y], (uint32_t) codes[r]);
+      }
+    });
+
+    // counts are turned into log probabilities in place
+
+    for(int y = 0; y < classes; y++)
+    {
+      double n = class_counts[y] - missing[y];
+      double total = n + alpha * feature.max_codes[y];
+      feature.unseen[y] = log(alpha / total);
+
+      if(dense)
+      {
+        for(uint32_t code = 0; code <= feature.cardinality; code++)
+        {
+          double & v = feature.dense[(size_t) code * classes + y];
+          v = (code >= 1 && code <= feature.max_codes[y]) ? log((v + alpha) / total) : -std::numeric_limits<double>::infinity();
+        }
+      } else
+      {
+        open_table<double> & table = feature.sparse[y];
+        for(size_t i = 0; i < table.keys.size(); i++)
+        {
+          if(table.keys[i] != open_table<double>::empty_key)
+          {
+            table.values[i] = log((table.values[i] + alpha) / total);
+          }
+        }
+      }
+    }
+
+    model.features.push_back(feature);
+  }
+
+  return model;
+}
+
+std::vector<int> coded_categorical_predict(const coded_categorical_model & model, const coded_dataset & dataset)
+{
+
+  /* Returns the argmax classification of every row, scoring one column at a time over all rows so each table stays in cache. Every lookup is O(1): an index into a dense table or a probe of an open addressing table. Code 0 marks a missing cell and is marginalised out, adding 0 to every class, while codes beyond the training cardinality have probability 0 in every class. */
+
+  const double negative_infinity = -std::numeric_limits<double>::infinity();
+
+  int classes = model.classes;
+  std::vector<double> scores((size_t) dataset.rows * classes);
+
+  for(int r = 0; r < dataset.rows; r++)
+  {
+    std::copy(model.log_priors.begin(), model.log_priors.end(), scores.begin() + (size_t) r * classes);
+  }
+
+  for(size_t j = 0; j < dataset.columns.size() && j < model.features.size(); j++)
+  {
+    const coded_feature & feature = model.features[j];
+
+    visit_codes(dataset.columns[j], [&](const auto * codes)
+    {
+      for(int r = 0; r < dataset.rows; r++)
+      {
+        double * row = &scores[(size_t) r * classes];
+        uint32_t code = codes[r];
+
+        if(code == 0)
+        {
+          continue;
+        } else if(code > feature.cardinality)
+        {
+          for(int y = 0; y < classes; y++)
+          {
+            row[y] = negative_infinity;
+          }
+        } else if(!feature.dense.empty())
+        {
+          const double * entry = &feature.dense[(size_t) code * classes];
+          for(int y = 0; y < classes; y++)
+          {
+            row[y] += entry[y];
+          }
+        } else
+        {
+          for(int y = 0; y < classes; y++)
+          {
+            const double * p = feature.sparse[y].find(code);
+            row[y] += p ? *p : ((code >= 1 && code <= feature.max_codes[y]) ? feature.unseen[y] : negative_infinity);
+          }
+        }
+      }
+    });
+  }
+
+  std::vector<int> predictions;
+
+  for(int r = 0; r < dataset.rows; r++)
+  {
+    const double * row = &scores[(size_t) r * classes];
+    predictions.push_back(std::max_element(row, row + classes) - row);
+  }
+
+  return predictions;
+}
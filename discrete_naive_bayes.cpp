@@ -0,0 +1,298 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/eigen3/Eigen/SparseCore"
+#include "includes/discrete_naive_bayes.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+std::vector<int> class_indicies_by_label(const Eigen::VectorXd & labels, std::vector<double> & classes)
+{
+
+  /* Maps each classification label to its position among the sorted unique labels, matching the class order of the other classifiers. Unique labels are appended to classes when it is empty. */
+
+  if(classes.empty())
+  {
+    classes.assign(labels.data(), labels.data() + labels.size());
+    std::sort(classes.begin(), classes.end());
+    classes.erase(std::unique(classes.begin(), classes.end()), classes.end());
+  }
+
+  std::vector<int> indicies;
+
+  for(auto v : labels)
+  {
+    indicies.push_back(std::lower_bound(classes.begin(), classes.end(), v) - classes.begin());
+  }
+
+  return indicies;
+}
+
+count_table count_by_classification(const SparseMatrixXd & X, const std::vector<int> & classifications, int classes)
+{
+
+  /* Accumulates per-class row counts and per-class feature sums in a single pass over the nonzeros of X. */
+
+  count_table counts;
+  counts.class_counts = Eigen::VectorXd::Zero(classes);
+  counts.feature_counts = Eigen::MatrixXd::Zero(X.cols(), classes);
+
+  for(int r = 0; r < X.outerSize(); r++)
+  {
+    int y = classifications[r];
+    counts.class_counts(y) += 1;
+
+    for(SparseMatrixXd::InnerIterator it(X, r); it; ++it)
+    {
+      counts.feature_counts(it.col(), y) += it.value();
+    }
+  }
+
+  return counts;
+}
+
+multinomial_model fit_multinomial(const count_table & counts, double alpha)
+{
+
+  /* Computes log P(y) and the Laplace smoothed log P(x_j | y) = log((N_jy + alpha) / (N_y + alpha * n_features)). */
+
+  multinomial_model model;
+
+  model.log_priors = (counts.class_counts / counts.class_counts.sum()).array().log().transpose();
+
+  Eigen::RowVectorXd totals = counts.feature_counts.colwise().sum().array() + alpha * counts.feature_counts.rows();
+  model.log_probabilities = ((counts.feature_counts.array() + alpha).rowwise() / totals.array()).log();
+
+  return model;
+}
+
+multinomial_model fit_complement(const count_table & counts, double alpha, bool normalize)
+{
+
+  /* Computes Complement NB weights from the same count table in one extra pass: each class is scored by how poorly the counts of every other class explain the row, w_jy = log((sum_{c != y} N_jc + alpha) / (sum_{c != y} N_c + alpha * n_features)). The weights are negated so multinomial_scores argmax picks the class with the least complement likelihood; the class priors are left out as in Rennie et al. (2003). */
+
+  multinomial_model model;
+
+  Eigen::MatrixXd complement_counts = (-counts.feature_counts).colwise() + counts.feature_counts.rowwise().sum();
+  Eigen::RowVectorXd totals = complement_counts.colwise().sum().array() + alpha * complement_counts.rows();
+
+  Eigen::ArrayXXd weights = ((complement_counts.array() + alpha).rowwise() / totals.array()).log();
+
+  if(normalize)
+  {
+    weights.rowwise() /= weights.abs().colwise().sum();
+  }
+
+  model.log_priors = Eigen::RowVectorXd::Zero(counts.class_counts.size());
+  model.log_probabilities = -weights.matrix();
+
+  return model;
+}
+
+Eigen::MatrixXd multinomial_scores(const multinomial_model & model, const SparseMatrixXd & X)
+{
+
+  /* Returns the unnormalized log posterior of every row and class as one sparse x dense product, so cost scales with the nonzeros of X. */
+
+  Eigen::MatrixXd scores = X * model.log_probabilities;
+  scores.rowwise() += model.log_priors;
+  return scores;
+}
+
+std::vector<int> argmax_rows(const Eigen::MatrixXd & scores)
+{
+
+  /* Returns the column index of the largest score in each row. */
+
+  std::vector<int> predictions;
+
+  for(int r = 0; r < scores.rows(); r++)
+  {
+    Eigen::Index pred;
+    scores.row(r).maxCoeff(&pred);
+    predictions.push_back(pred);
+  }
+
+  return predictions;
+}
+
+packed_rows pack_rows(const SparseMatrixXd & X)
+{
+
+  /* Packs the nonzero pattern of each row of X into 64 bit words. */
+
+  packed_rows packed;
+  packed.rows = X.rows();
+  packed.cols = X.cols();
+  packed.words = (X.cols() + 63) / 64;
+  packed.bits.assign((size_t) packed.rows * packed.words, 0);
+
+  for(int r = 0; r < X.outerSize(); r++)
+  {
+    for(SparseMatrixXd::InnerIterator it(X, r); it; ++it)
+    {
+      if(it.value() != 0.0)
+      {
+        packed.bits[(size_t) r * packed.words + it.col() / 64] |= (uint64_t) 1 << (it.col() % 64);
+      }
+    }
+  }
+
+  return packed;
+}
+
+count_table count_by_classification(const packed_rows & X, const std::vector<int> & classifications, int classes)
+{
+
+  /* Accumulates per-class row counts and per-class counts of each set feature in a single pass over the set bits of X. */
+
+  count_table counts;
+  counts.class_counts = Eigen::VectorXd::Zero(classes);
+  counts.feature_counts = Eigen::MatrixXd::Zero(X.cols, classes);
+
+  for(int r = 0; r < X.rows; r++)
+  {
+    int y = classifications[r];
+    counts.class_counts(y) += 1;
+
+    for(int w = 0; w < X.words; w++)
+    {
+      uint64_t bits = X.bits[(size_t) r * X.words + w];
+      while(bits)
+      {
+        counts.feature_counts(w * 64 + __builtin_ctzll(bits), y) += 1;
+        bits &= bits - 1;
+      }
+    }
+  }
+
+  return counts;
+}
+
+bernoulli_model fit_bernoulli(const count_table & counts, double alpha)
+{
+
+  /* Computes the score of an all zero row for each class and the log odds each set feature adds to it, with P(x_j = 1 | y) = (N_jy + alpha) / (N_y + 2 * alpha). */
+
+  bernoulli_model model;
+
+  Eigen::ArrayXXd p = (counts.feature_counts.array() + alpha).rowwise() / (counts.class_counts.array() + 2 * alpha).transpose();
+
+  Eigen::RowVectorXd log_priors = (counts.class_counts / counts.class_counts.sum()).array().log().transpose();
+
+  model.baselines = log_priors + (1 - p).log().matrix().colwise().sum();
+  model.log_odds = (p.log() - (1 - p).log()).matrix().transpose();
+
+  return model;
+}
+
+void quantize_bernoulli(bernoulli_model & model, int bit_planes, int words)
+{
+
+  /* Quantizes each class's log odds to bit_planes bits and stores bit b of every quantized weight as a packed plane, so the sum over set features becomes popcount(x) * minimum + step * sum_b 2^b * popcount(x & plane_b). The planes are words wide, the training width, so scored rows must be packed to the training columns. */
+
+  int classes = model.log_odds.rows();
+  int features = model.log_odds.cols();
+  double levels = (double) ((1 << bit_planes) - 1);
+
+  model.bit_planes = bit_planes;
+  model.minimums = model.log_odds.rowwise().minCoeff().transpose();
+  model.steps = (model.log_odds.rowwise().maxCoeff().transpose() - model.minimums) / levels;
+  model.planes.assign((size_t) classes * bit_planes * words, 0);
+
+  for(int y = 0; y < classes; y++)
+  {
+    for(int j = 0; j < features; j++)
+    {
+      uint64_t q = model.steps(y) > 0 ? (uint64_t) std::lround((model.log_odds(y, j) - model.minimums(y)) / model.steps(y)) : 0;
+
+      for(int b = 0; b < bit_planes; b++)
+      {
+        if((q >> b) & 1)
+        {
+          model.planes[((size_t) y * bit_planes + b) * words + j / 64] |= (uint64_t) 1 << (j % 64);
+        }
+      }
+    }
+  }
+}
+
+Eigen::MatrixXd bernoulli_scores(const bernoulli_model & model, const packed_rows & X)
+{
+
+  /* Returns the unnormalized log posterior of every row and class. Without quantization each row costs one log odds column per set bit, otherwise one popcount per class, plane, and word. */
+
+  int classes = model.baselines.size();
+  Eigen::MatrixXd scores(X.rows, classes);
+
+  for(int r = 0; r < X.rows; r++)
+  {
+    const uint64_t * row = &X.bits[(size_t) r * X.words];
+    Eigen::VectorXd score = model.baselines.transpose();
+
+    if(model.bit_planes == 0)
+    {
+      for(int w = 0; w < X.words; w++)
+      {
+        uint64_t bits = row[w];
+        while(bits)
+        {
+          score += model.log_odds.col(w * 64 + __builtin_ctzll(bits));
+          bits &= bits - 1;
+        }
+      }
+    } else
+    {
+      int set = 0;
+      for(int w = 0; w < X.words; w++)
+      {
+        set += __builtin_popcountll(row[w]);
+      }
+
+      for(int y = 0; y < classes; y++)
+      {
+        uint64_t weighted = 0;
+        for(int b = 0; b < model.bit_planes; b++)
+        {
+          const uint64_t * plane = &model.planes[((size_t) y * model.bit_planes + b) * X.words];
+          uint64_t count = 0;
+          for(int w = 0; w < X.words; w++)
+          {
+            count += __builtin_popcountll(row[w] & plane[w]);
+          }
+          weighted += count << b;
+        }
+        score(y) += set * model.minimums(y) + weighted * model.steps(y);
+      }
+    }
+
+    scores.row(r) = score.transpose();
+  }
+
+  return scores;
+}
+
+std::vector<int> bernoulli_naive_bayes_classifier(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length, bool verbose)
+{
+
+  /* Calculates the classification of each validation row with Bernoulli NB fit on the training rows, treating every nonzero feature as set. */
+
+  double alpha = 1.0;
+
+  if(verbose)
+  {
+  	printf("mode 4: bernoulli\n");
+  }
+
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(training.col(0).head(training_size), classes);
+
+  packed_rows X_train = pack_rows(training.block(0, 1, training_size, length - 1).sparseView());
+  packed_rows X_validation = pack_rows(validation.block(0, 1, validation_size, length - 1).sparseView());
+
+  bernoulli_model model = fit_bernoulli(count_by_classification(X_train, classifications, classes.size()), alpha);
+
+  return argmax_rows(bernoulli_scores(model, X_validation));
+}
@@ -0,0 +1,303 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <limits>
+#include <thread>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/nb_engine.h"
+#include "includes/discrete_naive_bayes.h"
+#include "includes/em_naive_bayes.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+struct em_statistics
+{
+  /* Weighted sufficient statistics of every class and feature, with values taken about the means of the previous iteration
+     so the variance is not lost to cancellation. */
+
+  Eigen::VectorXd class_weights;
+  Eigen::MatrixXd weights; // weights(y, k) = sum of the responsibilities of the rows where feature k is observed
+  Eigen::MatrixXd sums; // sum of r * (x - mean)
+  Eigen::MatrixXd squares; // sum of r * (x - mean)^2
+  double log_likelihood = 0.0;
+
+  em_statistics(int classes, int k_size) : class_weights(Eigen::VectorXd::Zero(classes)), weights(Eigen::MatrixXd::Zero(classes, k_size)), sums(Eigen::MatrixXd::Zero(classes, k_size)), squares(Eigen::MatrixXd::Zero(classes, k_size)) {}
+
+  void merge(const em_statistics & other)
+  {
+    class_weights += other.class_weights;
+    weights += other.weights;
+    sums += other.sums;
+    squares += other.squares;
+    log_likelihood += other.log_likelihood;
+  }
+};
+
+void em_log_posteriors(const em_model & model, const Eigen::MatrixXd & log_normalizers, const double * x, int k_size, double * scores)
+{
+
+  /* Writes log P(y) + sum_k log N(x_k; mean, sd) for every class into scores, leaving out missing (NaN) features. */
+
+  for(int y = 0; y < model.classes; y++)
+  {
+    double score = model.log_priors(y);
+    for(int k = 0; k < k_size; k++)
+    {
+      double z = (x[k] - model.means(y, k)) / model.standard_deviations(y, k);
+      score += (x[k] == x[k]) ? -0.5 * z * z - log_normalizers(y, k) : 0.0;
+    }
+    scores[y] = score;
+  }
+}
+
+void accumulate_row(const em_model & model, const double * x, int k_size, const double * responsibilities, em_statistics & statistics)
+{
+
+  /* Adds one row to the statistics with the given class responsibilities. */
+
+  for(int y = 0; y < model.classes; y++)
+  {
+    double r = responsibilities[y];
+    if(r == 0.0)
+    {
+      continue;
+    }
+
+    statistics.class_weights(y) += r;
+    for(int k = 0; k < k_size; k++)
+    {
+      if(x[k] == x[k])
+      {
+        double d = x[k] - model.means(y, k);
+        statistics.weights(y, k) += r;
+        statistics.sums(y, k) += r * d;
+        statistics.squares(y, k) += r * d * d;
+      }
+    }
+  }
+}
+
+void e_step(const em_model & model, const Eigen::MatrixXd & log_normalizers, const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> & X, int begin, int end, em_statistics & statistics)
+{
+
+  /* Computes the class responsibilities of rows begin .. end - 1 of X with a log sum exp, and adds the rows to statistics along with their marginal log likelihood. */
+
+  int k_size = X.cols();
+  std::vector<double> scores(model.classes);
+
+  for(int r = begin; r < end; r++)
+  {
+    const double * x = X.row(r).data();
+    em_log_posteriors(model, log_normalizers, x, k_size, scores.data());
+
+    double best = *std::max_element(scores.begin(), scores.end());
+    double total = 0.0;
+    for(auto & s : scores)
+    {
+      s = exp(s - best);
+      total += s;
+    }
+    for(auto & s : scores)
+    {
+      s /= total;
+    }
+
+    statistics.log_likelihood += best + log(total);
+    accumulate_row(model, x, k_size, scores.data(), statistics);
+  }
+}
+
+bool read_chunk(std::ifstream & in, const std::vector<int> & columns, int rows, Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> & X)
+{
+
+  /* Reads up to rows lines of a csv file into X, keeping only the given dataset columns after column 0. Cells that are not numbers are missing (NaN). Returns false once the file is exhausted and nothing was read. */
+
+  int k_size = columns.size() - 1;
+  std::vector<int> position;
+  for(int k = 0; k < k_size; k++)
+  {
+    if(columns[k + 1] >= (int) position.size())
+    {
+      position.resize(columns[k + 1] + 1, -1);
+    }
+    position[columns[k + 1]] = k;
+  }
+
+  X.resize(rows, k_size);
+  X.setConstant(std::numeric_limits<double>::quiet_NaN());
+
+  std::string line;
+  int r = 0;
+  while(r < rows && std::getline(in, line))
+  {
+    std::stringstream lineStream(line);
+    std::string cell;
+    size_t col = 0;
+    while(std::getline(lineStream, cell, ',') && col < position.size())
+    {
+      if(col > 0 && position[col] >= 0)
+      {
+        char * end = nullptr;
+        double value = strtod(cell.c_str(), &end);
+        if(end != cell.c_str())
+        {
+          X(r, position[col]) = value;
+        }
+      }
+      col++;
+    }
+    r++;
+  }
+
+  X.conservativeResize(r, k_size);
+  return r > 0;
+}
+
+em_model fit_semi_supervised_em(const Eigen::MatrixXd & labeled, int labeled_size, const std::vector<int> & columns, const std::string & unlabeled_path, const em_options & options)
+{
+
+  /* Fits Gaussian NB on the labeled rows (whose feature columns are columns 1 .. n of labeled, read from the given dataset columns of the unlabeled file), then runs EM over the unlabeled file until the relative change in log likelihood falls below the tolerance. */
+
+  int k_size = labeled.cols() - 1;
+
+  naive_bayes_engine<gaussian_distribution> engine;
+  for(int i = 1; i <= k_size; i++)
+  {
+    engine.columns<0>().push_back(i);
+  }
+
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(labeled.col(0).head(labeled_size), classes);
+  engine.fit(labeled, labeled_size, classifications, classes.size());
+
+  const feature_group<gaussian_distribution> & group = std::get<0>(engine.groups);
+
+  em_model model;
+  model.classes = engine.classes;
+  model.means.resize(model.classes, k_size);
+  model.standard_deviations.resize(model.classes, k_size);
+  model.log_priors = Eigen::Map<Eigen::VectorXd>(engine.log_priors.data(), model.classes);
+  model.class_weights = (model.log_priors.array().exp() * labeled_size).matrix();
+
+  for(int y = 0; y < model.classes; y++)
+  {
+    for(int k = 0; k < k_size; k++)
+    {
+      model.means(y, k) = group.parameters[y * k_size + k].mean;
+      model.standard_deviations(y, k) = group.parameters[y * k_size + k].standard_deviation;
+    }
+  }
+
+  int threads = options.threads > 0 ? options.threads : std::max(1, (int) std::thread::hardware_concurrency());
+
+  // labeled rows are stored row major like the chunks, with one hot responsibilities
+
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> labeled_rows = labeled.block(0, 1, labeled_size, k_size);
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> chunk;
+
+  double variance_floor = 1e-9 * std::max(model.standard_deviations.array().square().maxCoeff(), 1e-300);
+  double previous = -std::numeric_limits<double>::infinity();
+
+  for(int iteration = 0; iteration < options.max_iterations; iteration++)
+  {
+    Eigen::MatrixXd log_normalizers = (sqrt(2 * M_PI) * model.standard_deviations.array()).log().matrix();
+
+    em_statistics total(model.classes, k_size);
+    std::vector<double> one_hot(model.classes);
+    std::vector<double> scores(model.classes);
+
+    for(int r = 0; r < labeled_size; r++)
+    {
+      const double * x = labeled_rows.row(r).data();
+      em_log_posteriors(model, log_normalizers, x, k_size, scores.data());
+      std::fill(one_hot.begin(), one_hot.end(), 0.0);
+      one_hot[classifications[r]] = 1.0;
+      total.log_likelihood += scores[classifications[r]];
+      accumulate_row(model, x, k_size, one_hot.data(), total);
+    }
+
+    std::vector<em_statistics> partials(threads, em_statistics(model.classes, k_size));
+    long unlabeled_rows = 0;
+
+    std::ifstream in(unlabeled_path);
+    while(read_chunk(in, columns, options.chunk_rows, chunk))
+    {
+      int rows = chunk.rows();
+      int block = (rows + threads - 1) / threads;
+      std::vector<std::thread> workers;
+
+      for(int t = 0; t < threads && t * block < rows; t++)
+      {
+        workers.push_back(std::thread(e_step, std::cref(model), std::cref(log_normalizers), std::cref(chunk), t * block, std::min(rows, (t + 1) * block), std::ref(partials[t])));
+      }
+      for(auto & w : workers)
+      {
+        w.join();
+      }
+
+      unlabeled_rows += rows;
+    }
+
+    for(auto & p : partials)
+    {
+      total.merge(p);
+    }
+
+    // M-step: shift every mean by the weighted mean offset and take the weighted variance about the new mean
+
+    for(int y = 0; y < model.classes; y++)
+    {
+      for(int k = 0; k < k_size; k++)
+      {
+        double w = total.weights(y, k);
+        if(w > 0)
+        {
+          double offset = total.sums(y, k) / w;
+          model.means(y, k) += offset;
+          model.standard_deviations(y, k) = sqrt(std::max(total.squares(y, k) / w - offset * offset, variance_floor));
+        }
+      }
+    }
+
+    model.class_weights = total.class_weights;
+    model.log_priors = (total.class_weights.array() / total.class_weights.sum()).log().matrix();
+
+    if(options.verbose)
+    {
+      printf("EM iteration %d: %ld unlabeled rows, log likelihood %f\n", iteration + 1, unlabeled_rows, total.log_likelihood);
+    }
+
+    if(std::fabs(total.log_likelihood - previous) <= options.tolerance * std::fabs(total.log_likelihood))
+    {
+      break;
+    }
+    previous = total.log_likelihood;
+  }
+
+  return model;
+}
+
+std::vector<int> em_predict(const em_model & model, const Eigen::MatrixXd & X, int size)
+{
+
+  /* Returns the argmax classification of each of the first size rows of X, whose features are columns 1 .. n. */
+
+  int k_size = X.cols() - 1;
+  Eigen::MatrixXd log_normalizers = (sqrt(2 * M_PI) * model.standard_deviations.array()).log().matrix();
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rows = X.block(0, 1, size, k_size);
+
+  std::vector<int> predictions;
+  std::vector<double> scores(model.classes);
+
+  for(int r = 0; r < size; r++)
+  {
+    em_log_posteriors(model, log_normalizers, rows.row(r).data(), k_size, scores.data());
+    predictions.push_back(std::max_element(scores.begin(), scores.end()) - scores.begin());
+  }
+
+  return predictions;
+}
@@ -0,0 +1,356 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include <limits>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/eigen3/Eigen/StdVector"
+#include "includes/utils.h"
+#include "includes/naive_bayes.h"
+#include "includes/kfcv.h"
+#include "includes/feature_selection.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+const double log_floor = log(std::numeric_limits<double>::min()); // keeps log(0) finite so contributions can be added and subtracted
+
+template<typename Distribution> contribution_cache engine_contribution_cache(const naive_bayes_engine<Distribution> & engine, const Eigen::MatrixXd & validation, int validation_size)
+{
+
+  /* Caches log P(x_j | y) of a fitted single group engine for every feature, validation row, and class, with missing values contributing 0 as they do when the engine scores a row. */
+
+  const feature_group<Distribution> & group = std::get<0>(engine.groups);
+  int c = engine.classes;
+  int k_size = group.columns.size();
+
+  contribution_cache cache;
+  cache.log_priors = Eigen::Map<const Eigen::RowVectorXd>(engine.log_priors.data(), c);
+
+  for(int k = 0; k < k_size; k++)
+  {
+    Eigen::MatrixXd contributions(validation_size, c);
+
+    for(int y = 0; y < c; y++)
+    {
+      const typename Distribution::parameters & p = group.parameters[y * k_size + k];
+
+      for(int r = 0; r < validation_size; r++)
+      {
+        double x = validation(r, group.columns[k]);
+        contributions(r, y) = (x == x) ? std::max(group.distribution.log_likelihood(p, x), log_floor) : 0.0;
+      }
+    }
+
+    cache.features.push_back(contributions);
+  }
+
+  for(int r = 0; r < validation_size; r++)
+  {
+    cache.truth_labels.push_back(validation(r, 0));
+  }
+
+  return cache;
+}
+
+contribution_cache gaussian_contribution_cache(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length)
+{
+
+  /* Fits Gaussian NB on training and caches log P(x_j | y) for every feature, validation row, and class. */
+
+  return engine_contribution_cache(fit_gaussian_engine(training, training_size, length), validation, validation_size);
+}
+
+contribution_cache categorical_contribution_cache(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length)
+{
+
+  /* Fits Categorical NB on training and caches log P(x_j | y) for every feature, validation row, and class. */
+
+  double alpha = 1.0;
+
+  return engine_contribution_cache(fit_categorical_engine(training, training_size, length, alpha), validation, validation_size);
+}
+
+double selection_error(std::vector<contribution_cache> & caches, std::vector<Eigen::MatrixXd> & scores, int feature, double sign)
+{
+
+  /* Returns the mean cross validation error of the cached scores with one feature column added (sign = 1) or removed (sign = -1). */
+
+  double total_error = 0.0;
+
+  for(size_t f = 0; f < caches.size(); f++)
+  {
+    Eigen::MatrixXd candidate = scores[f];
+
+    if(feature >= 0)
+    {
+      candidate += sign * caches[f].features[feature];
+    }
+
+    int incorrect = 0;
+
+    for(int r = 0; r < candidate.rows(); r++)
+    {
+      Eigen::Index pred;
+      candidate.row(r).maxCoeff(&pred);
+
+      if(pred != caches[f].truth_labels[r])
+      {
+        incorrect += 1;
+      }
+    }
+
+    total_error += (double) incorrect / candidate.rows();
+  }
+
+  return total_error / caches.size();
+}
+
+std::vector<int> wrapper_feature_selection(Eigen::MatrixXd dataset, int K, contribution_cache (*cache_builder) (Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length), bool backward, bool verbose)
+{
+
+  /* Greedy forward (or backward) wrapper feature selection scored with K fold cross validation. Every fold is fit once and its per-feature log likelihood contributions are cached, so evaluating a candidate subset only adds or subtracts one cached column from the running class scores. Returns the selected dataset columns (column 0 is the classification). */
+
+  std::vector<Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic>, Eigen::aligned_allocator<Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic> > > folds = split(dataset,K);
+
+  std::vector<contribution_cache> caches;
+  std::vector<Eigen::MatrixXd> scores;
+
+  int length = dataset.rows() / K;
+  int num_features = dataset.cols() - 1;
+
+  for(int i = 0; i < K; i++)
+  {
+    Eigen::MatrixXd validation(length,dataset.cols());
+    Eigen::MatrixXd train(length * (K-1),dataset.cols());
+
+    int train_place = 0;
+
+    for(int idx = 0; idx < K; idx++)
+    {
+      if(idx == i)
+      {
+        validation = folds[idx];
+      } else
+      {
+        train.block(train_place, 0, length, dataset.cols()) = folds[idx];
+        train_place += length;
+      }
+    }
+
+    contribution_cache cache = cache_builder(validation, validation.rows(), train, train.rows(), train.cols());
+
+    Eigen::MatrixXd score = cache.log_priors.replicate(validation.rows(), 1);
+
+    if(backward)
+    {
+      for(auto v : cache.features)
+      {
+        score += v;
+      }
+    }
+
+    caches.push_back(cache);
+    scores.push_back(score);
+  }
+
+  std::vector<bool> selected(num_features, backward);
+  double best_error = selection_error(caches, scores, -1, 0.0);
+
+  if(verbose)
+  {
+    printf("feature selection start error -> %f\n", best_error);
+  }
+
+  int remaining = backward ? num_features : 0;
+
+  while(!(backward && remaining <= 1))
+  {
+    int best_feature = -1;
+    double sign = backward ? -1.0 : 1.0;
+    double candidate_best_error = best_error;
+
+    for(int j = 0; j < num_features; j++)
+    {
+      if(selected[j] != backward)
+      {
+        continue;
+      }
+
+      double error = selection_error(caches, scores, j, sign);
+
+      // ties favour the smaller subset when removing features
+
+      if(error < candidate_best_error || (backward && error <= candidate_best_error))
+      {
+        candidate_best_error = error;
+        best_feature = j;
+      }
+    }
+
+    if(best_feature == -1)
+    {
+      break;
+    }
+
+    for(size_t f = 0; f < caches.size(); f++)
+    {
+      scores[f] += sign * caches[f].features[best_feature];
+    }
+
+    selected[best_feature] = !backward;
+    remaining += backward ? -1 : 1;
+    best_error = candidate_best_error;
+
+    if(verbose)
+    {
+      printf("feature selection %s column %d error -> %f\n", backward ? "removed" : "added", best_feature + 1, best_error);
+    }
+  }
+
+  std::vector<int> columns;
+
+  for(int j = 0; j < num_features; j++)
+  {
+    if(selected[j])
+    {
+      columns.push_back(j + 1);
+    }
+  }
+
+  return columns;
+}
+
+Eigen::MatrixXd select_columns(Eigen::MatrixXd dataset, std::vector<int> columns)
+{
+
+  /* Returns the classification column followed by the given feature columns of dataset. */
+
+  Eigen::MatrixXd ret(dataset.rows(), columns.size() + 1);
+
+  ret.col(0) = dataset.col(0);
+
+  int idx = 1;
+  for(auto v : columns)
+  {
+    ret.col(idx++) = dataset.col(v);
+  }
+
+  return ret;
+}
+
+std::vector<double> gaussian_feature_scores(Eigen::MatrixXd training, int training_size, int length)
+{
+
+  /* Scores the class separability of each feature as the prior weighted mean symmetric KL divergence between its per-class Gaussians. */
+
+  naive_bayes_engine<gaussian_distribution> engine = fit_gaussian_engine(training, training_size, length);
+  const feature_group<gaussian_distribution> & group = std::get<0>(engine.groups);
+  int k_size = group.columns.size();
+  std::vector<double> scores;
+
+  for(int k = 0; k < k_size; k++)
+  {
+    double score = 0.0;
+    double weight = 0.0;
+
+    for(int a = 0; a < engine.classes; a++)
+    {
+      for(int b = a + 1; b < engine.classes; b++)
+      {
+        const gaussian_distribution::parameters & p_a = group.parameters[a * k_size + k];
+        const gaussian_distribution::parameters & p_b = group.parameters[b * k_size + k];
+        double var_a = p_a.standard_deviation * p_a.standard_deviation;
+        double var_b = p_b.standard_deviation * p_b.standard_deviation;
+        double d = p_a.mean - p_b.mean;
+        double w = exp(engine.log_priors[a] + engine.log_priors[b]);
+
+        // KL(a || b) + KL(b || a), where the log variance ratios cancel
+
+        score += w * ((var_a + d * d) / (2 * var_b) + (var_b + d * d) / (2 * var_a) - 1);
+        weight += w;
+      }
+    }
+
+    scores.push_back(weight > 0 ? score / weight : 0.0);
+  }
+
+  return scores;
+}
+
+std::vector<double> categorical_feature_scores(Eigen::MatrixXd training, int training_size, int length)
+{
+
+  /* Scores the class separability of each feature as the mutual information I(x_j ; y) in nats. */
+
+  std::vector<double> scores;
+  std::map<int, double> class_counts;
+
+  for(int r = 0; r < training_size; r++)
+  {
+    class_counts[(int) training(r, 0)] += 1;
+  }
+
+  for(int j = 1; j < length; j++)
+  {
+    std::map<int, double> label_counts;
+    std::map<std::pair<int,int>, double> joint_counts;
+
+    for(int r = 0; r < training_size; r++)
+    {
+      int label = training(r, j);
+      label_counts[label] += 1;
+      joint_counts[std::make_pair((int) training(r, 0), label)] += 1;
+    }
+
+    double score = 0.0;
+
+    for(auto v : joint_counts)
+    {
+      double p_xy = v.second / training_size;
+      double p_y = class_counts[v.first.first] / training_size;
+      double p_x = label_counts[v.first.second] / training_size;
+      score += p_xy * log(p_xy / (p_x * p_y));
+    }
+
+    scores.push_back(score);
+  }
+
+  return scores;
+}
+
+std::vector<int> prune_features(std::vector<double> scores, int top_k, double threshold, bool verbose)
+{
+
+  /* Returns the dataset columns (ascending, column 0 excluded) whose feature score is at least threshold and among the top_k highest. A top_k of 0 keeps every feature above threshold. */
+
+  std::vector<int> order;
+
+  for(size_t j = 0; j < scores.size(); j++)
+  {
+    order.push_back(j);
+
+    if(verbose)
+    {
+      printf("feature pruning column %d score -> %f\n", (int) j + 1, scores[j]);
+    }
+  }
+
+  std::stable_sort(order.begin(), order.end(), [&scores](int a, int b) { return scores[a] > scores[b]; });
+
+  std::vector<int> columns;
+
+  for(size_t i = 0; i < order.size(); i++)
+  {
+    if((top_k > 0 && (int) i >= top_k) || scores[order[i]] < threshold)
+    {
+      break;
+    }
+
+    columns.push_back(order[i] + 1);
+  }
+
+  std::sort(columns.begin(), columns.end());
+
+  return columns;
+}
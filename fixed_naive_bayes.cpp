@@ -0,0 +1,77 @@
+#include <iostream>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/fixed_naive_bayes.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Precompiled model dimensions. Any fitted or loaded Gaussian model whose feature and class counts are in these lists is
+   scored with the matching fixed size kernel. */
+
+typedef std::integer_sequence<int, 2, 3, 4, 5, 6, 7, 8, 9, 10> fixed_feature_counts;
+typedef std::integer_sequence<int, 2, 3, 4, 5> fixed_class_counts;
+
+template<int F, int C, typename Matrix, typename Vector> bool fixed_gaussian_kernel(const Matrix & means, const Matrix & standard_deviations, const Vector & log_priors, const Matrix & X, int size, std::vector<int> & predictions)
+{
+
+  /* Scores the first size rows of X (features in columns 1 .. F) with the F feature, C class kernel when the model has those dimensions. */
+
+  if(means.cols() != F || means.rows() != C)
+  {
+    return false;
+  }
+
+  typedef typename Matrix::Scalar Scalar;
+
+  const fixed_gaussian_model<F, C, Scalar> model(means, standard_deviations, log_priors);
+  Eigen::Matrix<Scalar, F, 1> x;
+
+  predictions.clear();
+  predictions.reserve(size);
+
+  for(int r = 0; r < size; r++)
+  {
+    x = X.template block<1, F>(r, 1).transpose();
+    predictions.push_back(model.predict(x));
+  }
+
+  return true;
+}
+
+template<int C, int... Fs, typename Matrix, typename Vector> bool fixed_gaussian_features(std::integer_sequence<int, Fs...>, const Matrix & means, const Matrix & standard_deviations, const Vector & log_priors, const Matrix & X, int size, std::vector<int> & predictions)
+{
+  return (fixed_gaussian_kernel<Fs, C>(means, standard_deviations, log_priors, X, size, predictions) || ...);
+}
+
+template<int... Cs, typename Matrix, typename Vector> bool fixed_gaussian_classes(std::integer_sequence<int, Cs...>, const Matrix & means, const Matrix & standard_deviations, const Vector & log_priors, const Matrix & X, int size, std::vector<int> & predictions)
+{
+  return (fixed_gaussian_features<Cs>(fixed_feature_counts(), means, standard_deviations, log_priors, X, size, predictions) || ...);
+}
+
+bool fixed_gaussian_predict(const Eigen::MatrixXd & means, const Eigen::MatrixXd & standard_deviations, const Eigen::VectorXd & log_priors, const Eigen::MatrixXd & X, int size, std::vector<int> & predictions)
+{
+
+  /* Predicts the first size rows of X with a precompiled fixed size kernel if one matches the model's classes x features means. Returns false, leaving predictions untouched, when no kernel matches. */
+
+  if(X.cols() != means.cols() + 1)
+  {
+    return false;
+  }
+
+  return fixed_gaussian_classes(fixed_class_counts(), means, standard_deviations, log_priors, X, size, predictions);
+}
+
+bool fixed_gaussian_predict(const Eigen::MatrixXf & means, const Eigen::MatrixXf & standard_deviations, const Eigen::VectorXf & log_priors, const Eigen::MatrixXf & X, int size, std::vector<int> & predictions)
+{
+
+  /* Single precision version of fixed_gaussian_predict. */
+
+  if(X.cols() != means.cols() + 1)
+  {
+    return false;
+  }
+
+  return fixed_gaussian_classes(fixed_class_counts(), means, standard_deviations, log_priors, X, size, predictions);
+}
@@ -0,0 +1,92 @@
+#ifndef CATEGORICAL_DATASET_H
+#define CATEGORICAL_DATASET_H
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include "label_dictionary.h"
+#include "open_table.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Categorical feature columns stored as integer codes in the narrowest of uint8, uint16, or uint32 that holds the
+   column's largest code. Code 0 marks a missing cell. Columns of non-negative integers are stored shifted by one, so the
+   integer v gets code v + 1 and 0 stays a category of its own. Any other column is interned into a per column dictionary
+   when the csv file is parsed, and the value with dictionary index i gets code i + 1. With feature hashing every cell is instead hashed into one of a fixed
+   number of buckets, code 1 + hash % buckets, so memory is bounded however many distinct values a column has. A
+   discretised continuous column keeps equal frequency bin edges, and a cell in bin b gets code b + 1. */
+
+struct column_codec
+{
+  bool raw = true; // codes are the integer cells + 1, otherwise they are the values dictionary indicies + 1
+  uint32_t buckets = 0; // when nonzero, codes are hashed cells and raw and values are unused
+  std::vector<double> edges; // when nonempty, codes are quantile bins of the cells and raw and values are unused
+  label_dictionary values;
+};
+
+struct coded_column
+{
+  int bytes = 1; // width of each code, only the matching vector below holds the codes
+  uint32_t max_code = 0;
+  std::vector<uint8_t> codes8;
+  std::vector<uint16_t> codes16;
+  std::vector<uint32_t> codes32;
+};
+
+struct coded_dataset
+{
+  int rows = 0;
+  std::vector<int> classifications; // class index of each row
+  std::vector<double> weights; // weight of each row, empty for unit weights
+  std::vector<coded_column> columns; // feature columns, dataset column j + 1 is columns[j]
+};
+
+struct coded_feature
+{
+  uint32_t cardinality = 0; // largest code seen in training
+
+  // features whose (codes x classes) table is small keep it dense
+
+  std::vector<double> dense; // dense[code * classes + y] = log P(x_j = code | y)
+
+  // any other feature keeps one open addressing table per class, holding only the codes seen in that class
+
+  std::vector<open_table<double>> sparse; // sparse[y][code] = log P(x_j = code | y)
+  std::vector<uint32_t> max_codes; // largest code seen in each class, larger codes have probability 0
+  std::vector<double> unseen; // log P(x_j = code | y) of the codes up to max_codes[y] that class y never saw
+};
+
+struct coded_categorical_model
+{
+  int classes = 0;
+  std::vector<double> log_priors; // log P(y)
+  std::vector<coded_feature> features;
+};
+
+template<typename F> void visit_codes(const coded_column & column, F f)
+{
+
+  /* Calls f with a pointer to the codes of column in their stored width. */
+
+  if(column.bytes == 1)
+  {
+    f(column.codes8.data());
+  } else if(column.bytes == 2)
+  {
+    f(column.codes16.data());
+  } else
+  {
+    f(column.codes32.data());
+  }
+}
+
+bool parse_code(const std::string &, uint32_t &);
+uint32_t hash_code(const std::string &, uint32_t);
+uint32_t bin_code(const std::string &, const std::vector<double> &);
+void set_codes(coded_column &, const std::vector<uint32_t> &);
+size_t coded_bytes(const coded_dataset &);
+coded_categorical_model fit_coded_categorical(const coded_dataset &, int, double);
+std::vector<int> coded_categorical_predict(const coded_categorical_model &, const coded_dataset &);
+
+#endif
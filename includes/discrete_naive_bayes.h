@@ -0,0 +1,62 @@
+#ifndef DISCRETE_NAIVE_BAYES_H
+#define DISCRETE_NAIVE_BAYES_H
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include "eigen3/Eigen/Dense"
+#include "eigen3/Eigen/SparseCore"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+typedef Eigen::SparseMatrix<double, Eigen::RowMajor> SparseMatrixXd;
+
+struct count_table
+{
+  Eigen::VectorXd class_counts; // number of rows of each class
+  Eigen::MatrixXd feature_counts; // feature_counts(j,y) = sum of feature j over rows of class y
+};
+
+struct multinomial_model
+{
+  Eigen::RowVectorXd log_priors; // log P(y)
+  Eigen::MatrixXd log_probabilities; // log_probabilities(j,y) = log P(x_j | y)
+};
+
+struct packed_rows
+{
+  int rows = 0;
+  int cols = 0;
+  int words = 0; // 64 bit words per row
+  std::vector<uint64_t> bits; // row r, feature j is bit j % 64 of bits[r * words + j / 64]
+};
+
+struct bernoulli_model
+{
+  Eigen::RowVectorXd baselines; // log P(y) + sum_j log(1 - P(x_j = 1 | y)), the score of an all zero row
+  Eigen::MatrixXd log_odds; // log_odds(y,j) = log P(x_j = 1 | y) - log(1 - P(x_j = 1 | y))
+
+  // optional bit plane quantization of log_odds, see quantize_bernoulli
+
+  int bit_planes = 0;
+  Eigen::RowVectorXd minimums; // smallest log odds of each class
+  Eigen::RowVectorXd steps; // quantization step of each class
+  std::vector<uint64_t> planes; // bit b of the quantized log odds of class y is planes[(y * bit_planes + b) * words + j / 64]
+};
+
+std::vector<int> class_indicies_by_label(const Eigen::VectorXd &, std::vector<double> &);
+count_table count_by_classification(const SparseMatrixXd &, const std::vector<int> &, int);
+multinomial_model fit_multinomial(const count_table &, double);
+multinomial_model fit_complement(const count_table &, double, bool);
+Eigen::MatrixXd multinomial_scores(const multinomial_model &, const SparseMatrixXd &);
+packed_rows pack_rows(const SparseMatrixXd &);
+count_table count_by_classification(const packed_rows &, const std::vector<int> &, int);
+bernoulli_model fit_bernoulli(const count_table &, double);
+void quantize_bernoulli(bernoulli_model &, int, int);
+Eigen::MatrixXd bernoulli_scores(const bernoulli_model &, const packed_rows &);
+std::vector<int> bernoulli_naive_bayes_classifier(Eigen::MatrixXd, int, Eigen::MatrixXd, int, int, bool);
+std::vector<int> argmax_rows(const Eigen::MatrixXd &);
+
+#endif
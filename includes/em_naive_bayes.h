@@ -0,0 +1,39 @@
+#ifndef EM_NAIVE_BAYES_H
+#define EM_NAIVE_BAYES_H
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <string>
+#include "eigen3/Eigen/Dense"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Semi-supervised Gaussian NB trained with expectation maximisation. The model starts from the labeled rows, then every
+   iteration streams the unlabeled csv file once in chunks. The E-step splits each chunk into one block per thread, and
+   every thread computes the class responsibilities of its rows and adds them to its own weighted sufficient statistics.
+   The M-step merges the per thread statistics with those of the labeled rows, whose responsibilities are fixed at their
+   labels. Only one chunk of unlabeled rows is held in memory at a time. */
+
+struct em_model
+{
+  int classes = 0;
+  Eigen::MatrixXd means; // means(y, k) of feature k within class y
+  Eigen::MatrixXd standard_deviations;
+  Eigen::VectorXd log_priors;
+  Eigen::VectorXd class_weights; // labeled rows plus the summed responsibilities of the unlabeled rows, per class
+};
+
+struct em_options
+{
+  int max_iterations = 100;
+  double tolerance = 1e-6; // stop once the log likelihood improves by less than this fraction
+  int threads = 0; // E-step threads, 0 uses every hardware thread
+  int chunk_rows = 16384; // unlabeled rows read per chunk
+  bool verbose = false;
+};
+
+em_model fit_semi_supervised_em(const Eigen::MatrixXd &, int, const std::vector<int> &, const std::string &, const em_options &);
+std::vector<int> em_predict(const em_model &, const Eigen::MatrixXd &, int);
+
+#endif
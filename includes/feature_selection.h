@@ -0,0 +1,28 @@
+#ifndef FEATURE_SELECTION_H
+#define FEATURE_SELECTION_H
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include "eigen3/Eigen/Dense"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+struct contribution_cache
+{
+  Eigen::RowVectorXd log_priors; // log P(y) for each class
+  std::vector<Eigen::MatrixXd> features; // features[j](r,y) = log P(x_j | y) for row r
+  std::vector<int> truth_labels;
+};
+
+contribution_cache gaussian_contribution_cache(Eigen::MatrixXd, int, Eigen::MatrixXd, int, int);
+contribution_cache categorical_contribution_cache(Eigen::MatrixXd, int, Eigen::MatrixXd, int, int);
+std::vector<int> wrapper_feature_selection(Eigen::MatrixXd, int, contribution_cache (*) (Eigen::MatrixXd, int, Eigen::MatrixXd, int, int), bool, bool);
+Eigen::MatrixXd select_columns(Eigen::MatrixXd, std::vector<int>);
+std::vector<double> gaussian_feature_scores(Eigen::MatrixXd, int, int);
+std::vector<double> categorical_feature_scores(Eigen::MatrixXd, int, int);
+std::vector<int> prune_features(std::vector<double>, int, double, bool);
+
+#endif
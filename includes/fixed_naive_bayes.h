@@ -0,0 +1,52 @@
+#ifndef FIXED_NAIVE_BAYES_H
+#define FIXED_NAIVE_BAYES_H
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "eigen3/Eigen/Dense"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Gaussian NB kernels for models with F features and C classes known at compile time. All parameters live in fixed size
+   Eigen matricies, so scoring a row is fully unrolled and never touches the heap. */
+
+template<int F, int C, typename Scalar = double> struct fixed_gaussian_model
+{
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
+
+  Eigen::Matrix<Scalar, C, F> means;
+  Eigen::Matrix<Scalar, C, F> scales; // 1 / (sqrt(2) * standard deviation), so the exponent is -((x - mean) * scale)^2
+  Eigen::Matrix<Scalar, C, 1> biases; // log P(y) - sum_j log(sqrt(2 pi) * standard deviation)
+  Eigen::Matrix<Scalar, C, F> log_normalizers; // log(sqrt(2 pi) * standard deviation), added back for missing features
+
+  fixed_gaussian_model(const Matrix & mean, const Matrix & standard_deviations, const Vector & log_priors)
+  {
+    means = mean;
+    scales = (Scalar(sqrt(2.0)) * standard_deviations.array()).inverse().matrix();
+    log_normalizers = (Scalar(sqrt(2 * M_PI)) * standard_deviations.array()).log().matrix();
+    biases = log_priors - log_normalizers.rowwise().sum();
+  }
+
+  Eigen::Matrix<Scalar, C, 1> log_posteriors(const Eigen::Matrix<Scalar, F, 1> & x) const
+  {
+    // a missing (NaN) feature is marginalised out by selecting minus its normalizer in place of its NaN exponent
+
+    Eigen::Array<Scalar, C, F> exponents = (means.rowwise() - x.transpose()).cwiseProduct(scales).array().square();
+    Eigen::Array<bool, 1, F> observed = x.transpose().array() == x.transpose().array();
+    return biases - observed.template replicate<C, 1>().select(exponents, -log_normalizers.array()).matrix().rowwise().sum();
+  }
+
+  int predict(const Eigen::Matrix<Scalar, F, 1> & x) const
+  {
+    Eigen::Index pred;
+    log_posteriors(x).maxCoeff(&pred);
+    return pred;
+  }
+};
+
+bool fixed_gaussian_predict(const Eigen::MatrixXd &, const Eigen::MatrixXd &, const Eigen::VectorXd &, const Eigen::MatrixXd &, int, std::vector<int> &);
+bool fixed_gaussian_predict(const Eigen::MatrixXf &, const Eigen::MatrixXf &, const Eigen::VectorXf &, const Eigen::MatrixXf &, int, std::vector<int> &);
+
+#endif
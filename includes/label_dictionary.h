@@ -0,0 +1,24 @@
+#ifndef LABEL_DICTIONARY_H
+#define LABEL_DICTIONARY_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Classification labels may be any int64, floating point, or string cell. Each distinct label is given a dense class
+   index 0 .. c - 1 when the training file is loaded, so the models only ever index flat arrays by class, and predictions
+   are decoded back into the original labels. Numeric labels are matched by value, so 1 and 1.0 are the same class. */
+
+struct label_dictionary
+{
+  std::vector<std::string> labels; // labels[y] = original text of the label with class index y
+  std::unordered_map<std::string, int> indicies; // canonical label text -> class index
+};
+
+std::vector<int> encode_labels(label_dictionary &, const std::vector<std::string> &);
+std::string decode_label(const label_dictionary &, int);
+
+#endif
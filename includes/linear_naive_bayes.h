@@ -0,0 +1,26 @@
+#ifndef LINEAR_NAIVE_BAYES_H
+#define LINEAR_NAIVE_BAYES_H
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "eigen3/Eigen/Dense"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Gaussian NB with one variance per feature pooled over the classes. The -x_j^2 / (2 var_j) term of every class is then
+   the same and drops out of the argmax, so the classifier is linear: score_y = w_y . x + b_y. A block of rows is scored
+   with a single matrix product, and the model holds half the parameters of the per class variance model. */
+
+struct linear_model
+{
+  int classes = 0;
+  Eigen::MatrixXd weights; // weights(y, k) = mean_yk / var_k
+  Eigen::VectorXd biases; // log P(y) - sum_k mean_yk^2 / (2 var_k)
+  Eigen::MatrixXd corrections; // corrections(y, k) = mean_yk^2 / (2 var_k), added back when feature k is missing
+};
+
+linear_model fit_tied_gaussian(const Eigen::MatrixXd &, int, int, const std::vector<double> & = std::vector<double>());
+std::vector<int> linear_predict(const linear_model &, const Eigen::MatrixXd &, int);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef LUT_NAIVE_BAYES_H
+#define LUT_NAIVE_BAYES_H
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "eigen3/Eigen/Dense"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+struct lut_model
+{
+  int bins = 0; // bins per feature, codes are uint8 up to 256 bins and uint16 beyond
+  int classes = 0;
+  std::vector<int> columns; // dataset columns, column 0 is the classification
+  std::vector<std::vector<double>> edges; // edges[k] holds the bins - 1 interior training quantiles of feature k
+  double scale = 1.0; // table entries are round(log likelihood * scale)
+  std::vector<int32_t> biases; // quantized log P(y)
+  std::vector<int16_t> tables; // tables[(k * bins + bin) * classes + y] = quantized log P(x_k in bin | y)
+};
+
+lut_model compile_lut(const Eigen::MatrixXd &, int, int, int);
+std::vector<int> lut_predict(const lut_model &, const Eigen::MatrixXd &, int);
+
+#endif
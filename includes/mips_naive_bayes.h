@@ -0,0 +1,31 @@
+#ifndef MIPS_NAIVE_BAYES_H
+#define MIPS_NAIVE_BAYES_H
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "eigen3/Eigen/Dense"
+#include "nb_engine.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* The Gaussian NB log posterior of every class is an inner product w_y . [x, x^2, observed, 1], where observed is 1 for
+   present values and 0 for missing ones, so the argmax over classes is a maximum inner product search. The index
+   clusters the classes into inverted lists at fit time, and a query only scores the classes in the lists whose centroids
+   are nearest to it. */
+
+struct mips_index
+{
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> weights; // weights.row(y) = w_y
+  Eigen::MatrixXd centroids; // centroids.row(l) = [c_l, 0, 0, 0], c_l the mean of the class means in list l
+  Eigen::VectorXd offsets; // -|c_l|^2 / 2, so centroids . query + offsets ranks lists by distance to the query
+  std::vector<std::vector<int>> lists; // class indicies in each inverted list, none of them empty
+};
+
+Eigen::MatrixXd gaussian_inner_product_weights(const naive_bayes_engine<gaussian_distribution> &);
+Eigen::MatrixXd augment_queries(const Eigen::MatrixXd &, int, const std::vector<int> &);
+mips_index build_mips_index(const Eigen::MatrixXd &, int, int);
+std::vector<std::vector<int>> mips_top_k(const mips_index &, const Eigen::MatrixXd &, int, int);
+std::vector<std::vector<int>> exhaustive_top_k(const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> &, const Eigen::MatrixXd &, int);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef MIXED_NAIVE_BAYES_H
+#define MIXED_NAIVE_BAYES_H
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include "eigen3/Eigen/Dense"
+#include "nb_engine.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+enum column_type { GAUSSIAN_COLUMN, CATEGORICAL_COLUMN, BERNOULLI_COLUMN, IGNORED_COLUMN };
+
+// a mixed model is the engine with one feature group per distribution: Gaussian columns, categorical columns, then Bernoulli columns
+
+typedef naive_bayes_engine<gaussian_distribution, categorical_distribution, bernoulli_distribution> mixed_model;
+
+std::vector<column_type> parse_schema(const std::string &, bool &);
+mixed_model fit_mixed(const Eigen::MatrixXd &, const std::vector<int> &, int, const std::vector<column_type> &, double);
+
+#endif
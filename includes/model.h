@@ -0,0 +1,28 @@
+#ifndef MODEL_H
+#define MODEL_H
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <fstream>
+#include "eigen3/Eigen/Dense"
+#include "lut_naive_bayes.h"
+#include "label_dictionary.h"
+#include "categorical_dataset.h"
+#include "pca.h"
+#include "nb_engine.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+std::string model_type(const std::string &);
+void save_gaussian_model(const std::string &, const naive_bayes_engine<gaussian_distribution> &, const std::vector<int> &, const label_dictionary &, const pca_projection * = nullptr);
+naive_bayes_engine<gaussian_distribution> load_gaussian_model(const std::string &, std::vector<int> &, label_dictionary &, pca_projection &);
+void save_categorical_model(const std::string &, const naive_bayes_engine<categorical_distribution> &, const std::vector<int> &, const label_dictionary &);
+naive_bayes_engine<categorical_distribution> load_categorical_model(const std::string &, std::vector<int> &, label_dictionary &);
+void save_lut_model(const std::string &, const lut_model &, const label_dictionary &, const pca_projection * = nullptr);
+lut_model load_lut_model(const std::string &, label_dictionary &, pca_projection &);
+void save_coded_categorical_model(const std::string &, const coded_categorical_model &, const std::vector<column_codec> &, const label_dictionary &, int = 0);
+coded_categorical_model load_coded_categorical_model(const std::string &, std::vector<column_codec> &, label_dictionary &, int &);
+
+#endif
@@ -9,20 +9,22 @@
 #include <fstream>
 #include "eigen3/Eigen/Dense"
 #include "utils.h"
+#include "nb_engine.h"
 
 /* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
 
-int len(const Eigen::VectorXd&);
-double mean(const Eigen::VectorXd&);
-double standard_deviation(const Eigen::VectorXd&);
-double gaussian_pdf(double, double, double);
-std::vector<int> class_indicies(Eigen::MatrixXd, int);
-std::vector<std::vector<double>> summarize_dataset(Eigen::MatrixXd, int);
-std::vector<Eigen::MatrixXd> matricies_by_classification(Eigen::MatrixXd, int, int);
-std::map<int, std::vector<std::vector<double>>> summarize_by_classification(Eigen::MatrixXd, int, int);
-std::map<int, double> calculate_classification_probabilities(std::map<int, std::vector<std::vector<double>>>, Eigen::VectorXd, int, bool);
-int predict(std::map<int, std::vector<std::vector<double>>>, Eigen::VectorXd, int, bool);
+naive_bayes_engine<gaussian_distribution> fit_gaussian_engine(const Eigen::MatrixXd &, int, int, const std::vector<double> & = std::vector<double>());
+std::vector<int> gaussian_engine_predict(const naive_bayes_engine<gaussian_distribution> &, const Eigen::MatrixXd &, int, bool);
+naive_bayes_engine<gaussian_distribution> gaussian_engine_from_moments(const Eigen::MatrixXd &, const Eigen::MatrixXd &, const Eigen::VectorXd &);
+naive_bayes_engine<categorical_distribution> fit_categorical_engine(const Eigen::MatrixXd &, int, int, double, const std::vector<double> & = std::vector<double>());
 std::vector<int> gaussian_naive_bayes_classifier(Eigen::MatrixXd, int, Eigen::MatrixXd, int, int, bool);
+std::vector<int> gaussian_naive_bayes_classifier(Eigen::MatrixXd, int, Eigen::MatrixXd, int, int, bool, const std::vector<double> &);
+std::vector<int> gaussian_naive_bayes_classifier(Eigen::MatrixXf, int, Eigen::MatrixXf, int, int, bool);
+std::vector<int> gaussian_rescored_classifier(Eigen::MatrixXd, int, Eigen::MatrixXd, int, int, double, rescoring_counters &);
+std::vector<int> gaussian_pruned_classifier(Eigen::MatrixXd, int, Eigen::MatrixXd, int, int, pruning_counters &);
+std::vector<int> kde_naive_bayes_classifier(Eigen::MatrixXd, int, Eigen::MatrixXd, int, int, int, const std::vector<double> & = std::vector<double>());
 std::vector<int> categorical_naive_bayes_classifier(Eigen::MatrixXd, int, Eigen::MatrixXd, int, int, bool);
+std::vector<int> categorical_naive_bayes_classifier(Eigen::MatrixXd, int, Eigen::MatrixXd, int, int, bool, const std::vector<double> &);
+std::vector<int> categorical_naive_bayes_classifier(Eigen::MatrixXf, int, Eigen::MatrixXf, int, int, bool);
 
 #endif
@@ -0,0 +1,702 @@
+#ifndef NB_ENGINE_H
+#define NB_ENGINE_H
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <vector>
+#include "eigen3/Eigen/Dense"
+#include "open_table.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Header-only naive bayes engine. The engine owns the partition / count / score skeleton shared by every model, and each
+   group of feature columns is handed to a distribution policy that supplies the per-feature math:
+
+     statistics                                  sufficient statistics of one feature within one class
+     parameters                                  fitted parameters of one feature within one class
+     void accumulate(statistics &, Scalar, Scalar)   adds one observed value with a positive weight
+     parameters finalize(const statistics &)     turns the statistics into parameters
+     Scalar log_likelihood(const parameters &, Scalar)   log P(x_j = x | y)
+     Scalar max_log_likelihood(const parameters &)       upper bound of log P(x_j = x | y) over x, used to prune classes
+
+   Policies are template arguments, so every model is compiled into its own fully inlined fit and score loops. The engine
+   and every policy are also templated on the scalar type, naive_bayes_engine is the double precision engine.
+
+   Missing values are NaN cells. Fit leaves them out of the statistics of their feature only, and scoring marginalises
+   them out, so policies never see a NaN. Rows may carry reliability weights, which fit rescales to average 1 so that
+   scaling every weight by a constant changes nothing, and rows of weight 0 are left out of the fit. */
+
+template<typename Scalar> struct basic_gaussian_distribution
+{
+  struct statistics { Scalar n = 0; Scalar squared_weights = 0; Scalar mean = 0; Scalar m2 = 0; };
+  struct parameters { Scalar mean; Scalar standard_deviation; Scalar log_normalizer; };
+
+  void accumulate(statistics & s, Scalar x, Scalar w) const
+  {
+    // West's weighted form of Welford's update, so the mean and sample variance are fit in a single pass
+
+    s.n += w;
+    s.squared_weights += w * w;
+    Scalar delta = x - s.mean;
+    s.mean += delta * w / s.n;
+    s.m2 += w * delta * (x - s.mean);
+  }
+
+  parameters finalize(const statistics & s) const
+  {
+    // the unbiased variance for reliability weights divides by V1 - V2 / V1, which is n - 1 for unit weights
+
+    return from_moments(s.mean, std::sqrt(s.m2 / (s.n - s.squared_weights / s.n)));
+  }
+
+  parameters from_moments(Scalar mean, Scalar standard_deviation) const
+  {
+    // also rebuilds saved models, which store only the mean and standard deviation
+
+    return parameters { mean, standard_deviation, std::log(Scalar(sqrt(2 * M_PI)) * standard_deviation) };
+  }
+
+  Scalar log_likelihood(const parameters & p, Scalar x) const
+  {
+    Scalar z = (x - p.mean) / p.standard_deviation;
+    return Scalar(-0.5) * z * z - p.log_normalizer;
+  }
+
+  Scalar max_log_likelihood(const parameters & p) const
+  {
+    return -p.log_normalizer;
+  }
+};
+
+template<typename Scalar> struct basic_categorical_distribution
+{
+  /* The K labels 0 .. max label seen in the class are smoothed with (count + alpha) / (n + alpha * K), any other label has
+     probability 0. Only the labels seen in a class are counted, in an open addressing table, and the labels up to max label
+     it never saw share one probability, so memory grows with the labels actually seen rather than the largest label. */
+
+  Scalar alpha = 1.0;
+
+  struct statistics { Scalar n = 0; uint32_t labels = 0; open_table<Scalar> counts; };
+  struct parameters { open_table<Scalar> log_probabilities; Scalar log_unseen = -std::numeric_limits<Scalar>::infinity(); uint32_t labels = 0; };
+
+  static bool labelled(Scalar x)
+  {
+    // labels are 0 .. UINT32_MAX - 1, as UINT32_MAX is the open table's empty key
+
+    return x >= 0 && x < Scalar(open_table<Scalar>::empty_key);
+  }
+
+  void accumulate(statistics & s, Scalar x, Scalar w) const
+  {
+    s.n += w;
+    if(labelled(x))
+    {
+      uint32_t label = (uint32_t) x;
+      s.counts[label] += w;
+      s.labels = std::max(s.labels, label + 1);
+    }
+  }
+
+  parameters finalize(const statistics & s) const
+  {
+    parameters p;
+    Scalar total = s.n + alpha * s.labels;
+    p.labels = s.labels;
+    p.log_unseen = std::log(alpha / total);
+    s.counts.for_each([&](uint32_t label, Scalar count) { p.log_probabilities[label] = std::log((count + alpha) / total); });
+    return p;
+  }
+
+  Scalar log_likelihood(const parameters & p, Scalar x) const
+  {
+    if(!labelled(x) || (uint32_t) x >= p.labels)
+    {
+      return -std::numeric_limits<Scalar>::infinity();
+    }
+    const Scalar * v = p.log_probabilities.find((uint32_t) x);
+    return v ? *v : p.log_unseen;
+  }
+
+  Scalar max_log_likelihood(const parameters & p) const
+  {
+    Scalar best = p.labels > 0 ? p.log_unseen : -std::numeric_limits<Scalar>::infinity();
+    p.log_probabilities.for_each([&](uint32_t, Scalar v) { best = std::max(best, v); });
+    return best;
+  }
+};
+
+template<typename Scalar> struct basic_bernoulli_distribution
+{
+  /* Any nonzero value counts as present, P(x_j != 0 | y) = (set + alpha) / (n + 2 * alpha). */
+
+  Scalar alpha = 1.0;
+
+  struct statistics { Scalar n = 0; Scalar set = 0; };
+  struct parameters { Scalar log_present; Scalar log_absent; };
+
+  void accumulate(statistics & s, Scalar x, Scalar w) const
+  {
+    s.n += w;
+    s.set += (x != Scalar(0)) ? w : Scalar(0);
+  }
+
+  parameters finalize(const statistics & s) const
+  {
+    Scalar p = (s.set + alpha) / (s.n + 2 * alpha);
+    return parameters { std::log(p), std::log(1 - p) };
+  }
+
+  Scalar log_likelihood(const parameters & p, Scalar x) const
+  {
+    return x != Scalar(0) ? p.log_present : p.log_absent;
+  }
+
+  Scalar max_log_likelihood(const parameters & p) const
+  {
+    return std::max(p.log_present, p.log_absent);
+  }
+};
+
+template<typename Scalar> struct basic_poisson_distribution
+{
+  /* Rate is the posterior mean under a Gamma(alpha, 1) prior, (sum + alpha) / (n + 1). */
+
+  Scalar alpha = 1.0;
+
+  struct statistics { Scalar n = 0; Scalar sum = 0; };
+  struct parameters { Scalar rate; Scalar log_rate; };
+
+  void accumulate(statistics & s, Scalar x, Scalar w) const
+  {
+    s.n += w;
+    s.sum += w * x;
+  }
+
+  parameters finalize(const statistics & s) const
+  {
+    Scalar rate = (s.sum + alpha) / (s.n + 1);
+    return parameters { rate, std::log(rate) };
+  }
+
+  Scalar log_likelihood(const parameters & p, Scalar x) const
+  {
+    return x * p.log_rate - p.rate - std::lgamma(x + 1);
+  }
+
+  Scalar max_log_likelihood(const parameters & p) const
+  {
+    // the Poisson mass peaks at floor(rate)
+
+    return log_likelihood(p, std::floor(p.rate));
+  }
+};
+
+template<typename Scalar> struct basic_kde_distribution
+{
+  /* Gaussian kernel density estimate with Silverman's bandwidth, tabulated once at fit time. The values of each class
+     are linearly binned onto a grid that spans them plus four bandwidths either side, and the grid counts are convolved
+     with the kernel truncated at four bandwidths. Scoring interpolates the log density table, so it costs the same as a
+     Gaussian likelihood however many training values there were. Values off the grid take the density at its edge. */
+
+  int grid = 512; // points per class and feature
+
+  struct statistics { std::vector<Scalar> values; std::vector<Scalar> weights; };
+  struct parameters { Scalar lo; Scalar inverse_step; std::vector<Scalar> log_densities; Scalar max_log_density; };
+
+  void accumulate(statistics & s, Scalar x, Scalar w) const
+  {
+    s.values.push_back(x);
+    s.weights.push_back(w);
+  }
+
+  parameters finalize(const statistics & s) const
+  {
+    const Scalar log_floor = std::log(std::numeric_limits<Scalar>::min());
+    int g = std::max(grid, 2);
+
+    if(s.values.empty())
+    {
+      return parameters { Scalar(0), Scalar(0), std::vector<Scalar>(2, log_floor), log_floor };
+    }
+
+    // values sorted with their weights, so the weighted quartiles are read off the cumulative weight
+
+    std::vector<std::pair<Scalar, Scalar>> sorted;
+    for(size_t i = 0; i < s.values.size(); i++)
+    {
+      sorted.push_back(std::make_pair(s.values[i], s.weights[i]));
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    Scalar n = 0;
+    Scalar squared_weights = 0;
+    Scalar mean = 0;
+    for(auto & v : sorted)
+    {
+      n += v.second;
+      squared_weights += v.second * v.second;
+      mean += v.second * v.first;
+    }
+    mean /= n;
+
+    // Kish's effective sample size n^2 / V2 is the number of values for unit weights and does not change when the weights are scaled
+
+    Scalar effective = n * n / squared_weights;
+
+    Scalar m2 = 0;
+    for(auto & v : sorted)
+    {
+      m2 += v.second * (v.first - mean) * (v.first - mean);
+    }
+    Scalar standard_deviation = effective > 1 ? std::sqrt(m2 / (n - squared_weights / n)) : Scalar(0);
+
+    // cumulative weights within a rounding error of q * n count as reaching it exactly, so rescaled weights give the same quartiles
+
+    Scalar tolerance = std::sqrt(std::numeric_limits<Scalar>::epsilon()) * n;
+
+    auto weighted_quantile = [&sorted, n, tolerance](Scalar q)
+    {
+      Scalar cumulative = 0;
+      for(auto & v : sorted)
+      {
+        cumulative += v.second;
+        if(cumulative > q * n + tolerance)
+        {
+          return v.first;
+        }
+      }
+      return sorted.back().first;
+    };
+
+    Scalar q1 = weighted_quantile(Scalar(0.25));
+    Scalar q3 = weighted_quantile(Scalar(0.75));
+    Scalar lo = sorted.front().first;
+    Scalar hi = sorted.back().first;
+
+    // Silverman's rule of thumb over the effective sample size, falling back to the standard deviation when the quartiles tie, and to a small width for constant features
+
+    Scalar spread = (q3 > q1) ? std::min(standard_deviation, (q3 - q1) / Scalar(1.34)) : standard_deviation;
+    Scalar bandwidth = Scalar(0.9) * spread * std::pow(std::max(effective, Scalar(1)), Scalar(-0.2));
+    if(!(bandwidth > 0))
+    {
+      bandwidth = Scalar(1e-3) * std::max(std::fabs(mean), Scalar(1));
+    }
+
+    lo -= 4 * bandwidth;
+    hi += 4 * bandwidth;
+    Scalar step = (hi - lo) / (g - 1);
+
+    std::vector<Scalar> counts(g, Scalar(0));
+    for(auto & v : sorted)
+    {
+      Scalar t = (v.first - lo) / step;
+      int i = std::min(std::max((int) t, 0), g - 2);
+      Scalar frac = std::min(std::max(t - i, Scalar(0)), Scalar(1));
+      counts[i] += v.second * (1 - frac);
+      counts[i + 1] += v.second * frac;
+    }
+
+    int width = std::min(g - 1, (int) std::ceil(4 * bandwidth / step));
+    std::vector<Scalar> kernel(width + 1);
+    for(int d = 0; d <= width; d++)
+    {
+      Scalar z = d * step / bandwidth;
+      kernel[d] = std::exp(Scalar(-0.5) * z * z) / (n * bandwidth * Scalar(sqrt(2 * M_PI)));
+    }
+
+    parameters p { lo, 1 / step, std::vector<Scalar>(g), log_floor };
+    for(int i = 0; i < g; i++)
+    {
+      Scalar density = 0;
+      for(int j = std::max(0, i - width); j <= std::min(g - 1, i + width); j++)
+      {
+        density += counts[j] * kernel[std::abs(i - j)];
+      }
+      p.log_densities[i] = std::max(std::log(density), log_floor);
+      p.max_log_density = std::max(p.max_log_density, p.log_densities[i]);
+    }
+
+    return p;
+  }
+
+  Scalar log_likelihood(const parameters & p, Scalar x) const
+  {
+    int last = p.log_densities.size() - 1;
+    Scalar t = std::min(std::max((x - p.lo) * p.inverse_step, Scalar(0)), Scalar(last));
+    int i = std::min((int) t, last - 1);
+    Scalar frac = t - i;
+    return p.log_densities[i] + frac * (p.log_densities[i + 1] - p.log_densities[i]);
+  }
+
+  Scalar max_log_likelihood(const parameters & p) const
+  {
+    return p.max_log_density;
+  }
+};
+
+typedef basic_gaussian_distribution<double> gaussian_distribution;
+typedef basic_categorical_distribution<double> categorical_distribution;
+typedef basic_bernoulli_distribution<double> bernoulli_distribution;
+typedef basic_poisson_distribution<double> poisson_distribution;
+typedef basic_kde_distribution<double> kde_distribution;
+
+template<typename Distribution, typename Scalar> inline Scalar observed_log_likelihood(const Distribution & distribution, const typename Distribution::parameters & p, Scalar x)
+{
+
+  /* Returns log P(x_j = x | y), or 0 (log 1) when x is missing. The policy is evaluated at 0 in place of a missing value and
+     the result masked with a select rather than a branch, so complete and incomplete rows run the same straight line code. */
+
+  bool observed = (x == x);
+  Scalar log_likelihood = distribution.log_likelihood(p, observed ? x : Scalar(0));
+  return observed ? log_likelihood : Scalar(0);
+}
+
+template<typename Distribution> struct feature_group
+{
+  Distribution distribution;
+  std::vector<int> columns; // dataset columns scored by this group
+  std::vector<typename Distribution::statistics> statistics; // statistics[y * columns.size() + k]
+  std::vector<typename Distribution::parameters> parameters; // parameters[y * columns.size() + k]
+};
+
+template<typename Scalar, typename... Distributions> class basic_naive_bayes_engine
+{
+  public:
+
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+
+  std::tuple<feature_group<Distributions>...> groups;
+  std::vector<Scalar> log_priors;
+  int classes = 0;
+
+  template<size_t I> std::vector<int> & columns()
+  {
+
+    /* Returns the dataset columns of the I'th feature group. */
+
+    return std::get<I>(groups).columns;
+  }
+
+  template<size_t I> auto & distribution()
+  {
+
+    /* Returns the policy of the I'th feature group, e.g. to set its smoothing. */
+
+    return std::get<I>(groups).distribution;
+  }
+
+  void fit(const Matrix & X, int size, const std::vector<int> & classifications, int num_classes, const std::vector<Scalar> & weights = std::vector<Scalar>())
+  {
+
+    /* Fits every feature group in a single pass over the rows of X, where classifications holds the class index of each row and weights the weight of each row (empty for unit weights). */
+
+    classes = num_classes;
+    std::vector<Scalar> class_counts(classes, Scalar(0));
+    Scalar total = 0;
+
+    std::apply([&](auto & ... group) { (reset(group), ...); }, groups);
+
+    // weights are rescaled to average 1 over the rows they keep, so smoothing sees the same counts however they are scaled
+
+    Scalar scale = 1;
+    if(!weights.empty())
+    {
+      Scalar sum = 0;
+      int kept = 0;
+      for(int r = 0; r < size; r++)
+      {
+        if(weights[r] > 0)
+        {
+          sum += weights[r];
+          kept++;
+        }
+      }
+      scale = sum > 0 ? kept / sum : Scalar(1);
+    }
+
+    for(int r = 0; r < size; r++)
+    {
+      int y = classifications[r];
+      Scalar w = weights.empty() ? Scalar(1) : weights[r] * scale;
+      if(!(w > 0))
+      {
+        continue;
+      }
+      class_counts[y] += w;
+      total += w;
+      std::apply([&](auto & ... group) { (accumulate_row(group, X, r, y, w), ...); }, groups);
+    }
+
+    std::apply([&](auto & ... group) { (finalize(group), ...); }, groups);
+
+    log_priors.resize(classes);
+    for(int y = 0; y < classes; y++)
+    {
+      log_priors[y] = std::log(class_counts[y] / total);
+    }
+  }
+
+  template<typename Row> void log_posteriors(const Row & row, Scalar * scores) const
+  {
+
+    /* Writes the unnormalized log posterior log P(y) + sum_j log P(x_j | y) of row for every class into scores. */
+
+    for(int y = 0; y < classes; y++)
+    {
+      scores[y] = log_priors[y];
+    }
+
+    std::apply([&](const auto & ... group) { (score_row(group, row, scores), ...); }, groups);
+  }
+
+  std::vector<int> predict(const Matrix & X, int size) const
+  {
+
+    /* Returns the argmax classification of each of the first size rows of X. */
+
+    std::vector<int> predictions;
+    std::vector<Scalar> scores(classes);
+
+    for(int r = 0; r < size; r++)
+    {
+      log_posteriors(X.row(r), scores.data());
+      predictions.push_back(std::max_element(scores.begin(), scores.end()) - scores.begin());
+    }
+
+    return predictions;
+  }
+
+  private:
+
+  template<typename Group> void reset(Group & group)
+  {
+    group.statistics.assign(classes * group.columns.size(), typename decltype(group.statistics)::value_type());
+  }
+
+  template<typename Group> void accumulate_row(Group & group, const Matrix & X, int r, int y, Scalar w)
+  {
+    size_t k_size = group.columns.size();
+    for(size_t k = 0; k < k_size; k++)
+    {
+      Scalar x = X(r, group.columns[k]);
+      if(x == x)
+      {
+        group.distribution.accumulate(group.statistics[y * k_size + k], x, w);
+      }
+    }
+  }
+
+  template<typename Group> void finalize(Group & group)
+  {
+    group.parameters.clear();
+    for(auto & s : group.statistics)
+    {
+      group.parameters.push_back(group.distribution.finalize(s));
+    }
+  }
+
+  template<typename Group, typename Row> void score_row(const Group & group, const Row & row, Scalar * scores) const
+  {
+    size_t k_size = group.columns.size();
+    for(int y = 0; y < classes; y++)
+    {
+      const auto * parameters = &group.parameters[y * k_size];
+      Scalar score = 0;
+      for(size_t k = 0; k < k_size; k++)
+      {
+        score += observed_log_likelihood(group.distribution, parameters[k], Scalar(row(group.columns[k])));
+      }
+      scores[y] += score;
+    }
+  }
+};
+
+struct rescoring_counters
+{
+  long rows = 0; // rows scored in the fast precision
+  long rescored = 0; // rows whose top two classes were within the margin and were rescored in the exact precision
+  long changed = 0; // rescored rows whose argmax changed
+};
+
+template<typename FastEngine, typename ExactEngine> std::vector<int> predict_rescored(const FastEngine & fast, const ExactEngine & exact, const typename FastEngine::Matrix & X_fast, const typename ExactEngine::Matrix & X_exact, int size, double margin, rescoring_counters & counters)
+{
+
+  /* Batch predictor that scores every row with the fast (e.g. float) engine, and only rescores rows whose top two class log scores are within margin of each other with the exact (e.g. double) engine. Both engines must be fit on the same data and classes. */
+
+  std::vector<int> predictions;
+  std::vector<typename FastEngine::Matrix::Scalar> fast_scores(fast.classes);
+  std::vector<typename ExactEngine::Matrix::Scalar> exact_scores(exact.classes);
+
+  for(int r = 0; r < size; r++)
+  {
+    fast.log_posteriors(X_fast.row(r), fast_scores.data());
+
+    int best = 0;
+    int second = -1;
+    for(int y = 1; y < fast.classes; y++)
+    {
+      if(fast_scores[y] > fast_scores[best])
+      {
+        second = best;
+        best = y;
+      } else if(second == -1 || fast_scores[y] > fast_scores[second])
+      {
+        second = y;
+      }
+    }
+
+    counters.rows++;
+
+    if(second != -1 && !(fast_scores[best] - fast_scores[second] >= margin))
+    {
+      exact.log_posteriors(X_exact.row(r), exact_scores.data());
+      int exact_best = std::max_element(exact_scores.begin(), exact_scores.end()) - exact_scores.begin();
+
+      counters.rescored++;
+      counters.changed += (exact_best != best);
+      best = exact_best;
+    }
+
+    predictions.push_back(best);
+  }
+
+  return predictions;
+}
+
+struct pruning_counters
+{
+  long rows = 0;
+  long evaluations = 0; // feature log likelihoods evaluated
+  long full_evaluations = 0; // feature log likelihoods a full scan of every class would evaluate
+};
+
+template<typename Scalar, typename Distribution> std::vector<int> predict_pruned(const basic_naive_bayes_engine<Scalar, Distribution> & engine, const std::vector<int> & order, const typename basic_naive_bayes_engine<Scalar, Distribution>::Matrix & X, int size, pruning_counters & counters)
+{
+
+  /* Exact branch and bound argmax for single group engines with many classes. Features are accumulated in the given order (indices into the group columns, most discriminative first) for the classes still in play. Whenever the leading class changes it is scored in full, and any class whose partial score plus the upper bound of its remaining features falls below the best full score can no longer win and is dropped. The survivors are rescored in column order, so the argmax matches engine.predict. */
+
+  const feature_group<Distribution> & group = std::get<0>(engine.groups);
+  int classes = engine.classes;
+  int k_size = group.columns.size();
+
+  // bounds[t * classes + y] = sum of the max log likelihoods of features order[t ..] for class y
+
+  // a missing value contributes 0, which can exceed a negative maximum, so rows with missing values use bounds clamped at 0
+
+  std::vector<Scalar> bounds((size_t) (k_size + 1) * classes, Scalar(0));
+  std::vector<Scalar> missing_bounds((size_t) (k_size + 1) * classes, Scalar(0));
+  for(int t = k_size - 1; t >= 0; t--)
+  {
+    for(int y = 0; y < classes; y++)
+    {
+      Scalar bound = group.distribution.max_log_likelihood(group.parameters[(size_t) y * k_size + order[t]]);
+      bounds[(size_t) t * classes + y] = bounds[(size_t) (t + 1) * classes + y] + bound;
+      missing_bounds[(size_t) t * classes + y] = missing_bounds[(size_t) (t + 1) * classes + y] + std::max(bound, Scalar(0));
+    }
+  }
+
+  Scalar epsilon = std::numeric_limits<Scalar>::epsilon() * 8 * (k_size + 1);
+
+  std::vector<int> predictions;
+  std::vector<Scalar> partial(classes);
+  std::vector<Scalar> full(classes);
+  std::vector<char> scored(classes);
+  std::vector<int> active;
+
+  auto full_score = [&](int y, const auto & row)
+  {
+    // same summation order as the engine's score_row
+
+    const auto * parameters = &group.parameters[(size_t) y * k_size];
+    Scalar score = 0;
+    for(int k = 0; k < k_size; k++)
+    {
+      score += observed_log_likelihood(group.distribution, parameters[k], Scalar(row(group.columns[k])));
+    }
+    counters.evaluations += k_size;
+    return engine.log_priors[y] + score;
+  };
+
+  for(int r = 0; r < size; r++)
+  {
+    auto row = X.row(r);
+    const std::vector<Scalar> & row_bounds = row.hasNaN() ? missing_bounds : bounds;
+
+    active.resize(classes);
+    for(int y = 0; y < classes; y++)
+    {
+      active[y] = y;
+      partial[y] = engine.log_priors[y];
+      scored[y] = 0;
+    }
+
+    Scalar best = -std::numeric_limits<Scalar>::infinity();
+
+    for(int t = 0; t < k_size && active.size() > 1; t++)
+    {
+      int k = order[t];
+      Scalar x = row(group.columns[k]);
+
+      int leader = active[0];
+      for(auto y : active)
+      {
+        partial[y] += observed_log_likelihood(group.distribution, group.parameters[(size_t) y * k_size + k], x);
+        if(partial[y] > partial[leader])
+        {
+          leader = y;
+        }
+      }
+      counters.evaluations += active.size();
+
+      if(!scored[leader])
+      {
+        full[leader] = full_score(leader, row);
+        scored[leader] = 1;
+        best = std::max(best, full[leader]);
+      }
+
+      Scalar threshold = best - epsilon * (1 + std::fabs(best));
+      const Scalar * remaining = &row_bounds[(size_t) (t + 1) * classes];
+
+      size_t kept = 0;
+      for(auto y : active)
+      {
+        if(!(partial[y] + remaining[y] < threshold))
+        {
+          active[kept++] = y;
+        }
+      }
+      active.resize(kept);
+    }
+
+    int prediction = -1;
+    Scalar prediction_score = 0;
+
+    for(auto y : active)
+    {
+      if(!scored[y])
+      {
+        full[y] = full_score(y, row);
+      }
+
+      if(prediction == -1 || full[y] > prediction_score)
+      {
+        prediction = y;
+        prediction_score = full[y];
+      }
+    }
+
+    counters.rows++;
+    counters.full_evaluations += (long) classes * k_size;
+    predictions.push_back(prediction);
+  }
+
+  return predictions;
+}
+
+template<typename... Distributions> using naive_bayes_engine = basic_naive_bayes_engine<double, Distributions...>;
+
+#endif
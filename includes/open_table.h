@@ -0,0 +1,124 @@
+#ifndef OPEN_TABLE_H
+#define OPEN_TABLE_H
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Open addressing hash table from uint32 codes to values with linear probing over a power of two number of slots.
+   Keys and values are kept in two flat arrays, so a lookup is a multiply, a shift, and usually one cache line. */
+
+template<typename Value> struct open_table
+{
+  static constexpr uint32_t empty_key = UINT32_MAX; // marks an unused slot, so it cannot be stored as a key
+
+  std::vector<uint32_t> keys;
+  std::vector<Value> values;
+  size_t size = 0;
+  int shift = 32;
+
+  size_t slot(uint32_t key) const
+  {
+    // Fibonacci hashing spreads consecutive codes over the slots
+
+    return shift >= 32 ? 0 : (uint32_t) (key * 2654435769u) >> shift;
+  }
+
+  Value & operator[](uint32_t key)
+  {
+
+    /* Returns the value of key, inserting a default value first when key is not in the table. */
+
+    if(2 * (size + 1) > keys.size())
+    {
+      grow();
+    }
+
+    size_t mask = keys.size() - 1;
+    size_t i = slot(key);
+    while(keys[i] != empty_key && keys[i] != key)
+    {
+      i = (i + 1) & mask;
+    }
+
+    if(keys[i] == empty_key)
+    {
+      keys[i] = key;
+      values[i] = Value();
+      size++;
+    }
+
+    return values[i];
+  }
+
+  const Value * find(uint32_t key) const
+  {
+
+    /* Returns the value of key, or nullptr when key is not in the table. */
+
+    if(keys.empty())
+    {
+      return nullptr;
+    }
+
+    size_t mask = keys.size() - 1;
+    size_t i = slot(key);
+    while(keys[i] != empty_key)
+    {
+      if(keys[i] == key)
+      {
+        return &values[i];
+      }
+      i = (i + 1) & mask;
+    }
+
+    return nullptr;
+  }
+
+  template<typename F> void for_each(F f) const
+  {
+
+    /* Calls f(key, value) for every entry, in slot order. */
+
+    for(size_t i = 0; i < keys.size(); i++)
+    {
+      if(keys[i] != empty_key)
+      {
+        f(keys[i], values[i]);
+      }
+    }
+  }
+
+  private:
+
+  void grow()
+  {
+    std::vector<uint32_t> old_keys;
+    std::vector<Value> old_values;
+    old_keys.swap(keys);
+    old_values.swap(values);
+
+    size_t slots = old_keys.empty() ? 8 : 2 * old_keys.size();
+    keys.assign(slots, empty_key);
+    values.assign(slots, Value());
+    size = 0;
+
+    shift = 32;
+    while(((size_t) 1 << (32 - shift)) < slots)
+    {
+      shift--;
+    }
+
+    for(size_t i = 0; i < old_keys.size(); i++)
+    {
+      if(old_keys[i] != empty_key)
+      {
+        (*this)[old_keys[i]] = old_values[i];
+      }
+    }
+  }
+};
+
+#endif
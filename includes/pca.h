@@ -0,0 +1,26 @@
+#ifndef PCA_H
+#define PCA_H
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "eigen3/Eigen/Dense"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Whitening PCA stage fit on the training features. The top components are found from the eigendecomposition of the
+   covariance matrix, or for wide data with a randomized range finder that never forms it. Each component is divided by
+   the square root of its variance, so the projected features are uncorrelated with unit variance. Missing (NaN) cells are
+   projected as the training mean of their feature. */
+
+struct pca_projection
+{
+  Eigen::RowVectorXd mean; // training mean of every feature
+  Eigen::MatrixXd components; // components.col(i) = i'th principal direction / sqrt(its variance)
+  Eigen::VectorXd variances; // variance along each kept component, largest first
+};
+
+pca_projection fit_pca(const Eigen::MatrixXd &, int, int, int);
+Eigen::MatrixXd apply_pca(const pca_projection &, const Eigen::MatrixXd &, int);
+
+#endif
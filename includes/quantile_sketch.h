@@ -0,0 +1,29 @@
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <iostream>
+#include <vector>
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Streaming quantile sketch in the style of a merging t-digest. Values are buffered, and whenever the buffer fills it is
+   sorted and merged into a list of (mean, weight) centroids, where adjacent centroids are combined while their weight
+   stays within total / capacity. Memory is bounded by the capacity however many values are added, and any quantile is
+   within about 1 / capacity of its exact rank. */
+
+struct quantile_sketch
+{
+  size_t capacity = 1000; // centroids kept after a compression
+  double total = 0; // weight of every value added
+  std::vector<double> means;
+  std::vector<double> weights;
+  std::vector<double> buffer; // values added since the last compression
+
+  void add(double);
+  void compress();
+  double quantile(double);
+};
+
+std::vector<double> equal_frequency_edges(quantile_sketch &, int);
+
+#endif
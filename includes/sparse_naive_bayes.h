@@ -0,0 +1,23 @@
+#ifndef SPARSE_NAIVE_BAYES_H
+#define SPARSE_NAIVE_BAYES_H
+
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "eigen3/Eigen/Dense"
+#include "eigen3/Eigen/SparseCore"
+#include "discrete_naive_bayes.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+struct sparse_gaussian_model
+{
+  Eigen::RowVectorXd baselines; // log P(y) + sum_j log N(0; mean, sd), the score of an all zero row
+  Eigen::MatrixXd linear; // linear(j,y) = mean / sd^2
+  Eigen::MatrixXd quadratic; // quadratic(j,y) = -1 / (2 sd^2), so a nonzero x_j adds quadratic * x^2 + linear * x
+};
+
+sparse_gaussian_model fit_sparse_gaussian(const SparseMatrixXd &, const std::vector<int> &, int, double);
+Eigen::MatrixXd sparse_gaussian_scores(const sparse_gaussian_model &, const SparseMatrixXd &);
+
+#endif
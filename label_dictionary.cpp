@@ -0,0 +1,152 @@
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <cerrno>
+#include <cmath>
+#include <unordered_map>
+#include "includes/label_dictionary.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+struct parsed_label
+{
+  std::string text; // trimmed original text
+  std::string key; // canonical text, equal for equal numeric values
+  bool numeric = false;
+  bool integral = false;
+  long long integer = 0;
+  long double real = 0;
+};
+
+parsed_label parse_label(const std::string & cell)
+{
+
+  /* Trims a label cell and parses it as an int64, then as a floating point number, and otherwise keeps it as a string. */
+
+  parsed_label label;
+
+  size_t first = cell.find_first_not_of(" \t\r\n\"");
+  size_t last = cell.find_last_not_of(" \t\r\n\"");
+  label.text = first == std::string::npos ? "" : cell.substr(first, last - first + 1);
+  label.key = label.text;
+
+  if(label.text.empty())
+  {
+    return label;
+  }
+
+  const char * begin = label.text.c_str();
+  char * end = nullptr;
+
+  errno = 0;
+  long long integer = std::strtoll(begin, &end, 10);
+  if(*end == '\0' && errno == 0)
+  {
+    label.numeric = label.integral = true;
+    label.integer = integer;
+    label.real = integer;
+    label.key = std::to_string(integer);
+    return label;
+  }
+
+  long double real = std::strtold(begin, &end);
+  if(*end == '\0')
+  {
+    label.numeric = true;
+    label.real = real;
+
+    if(std::floor(real) == real && std::fabs(real) < 9.2e18)
+    {
+      label.integral = true;
+      label.integer = (long long) real;
+      label.key = std::to_string(label.integer);
+    } else
+    {
+      char buffer[64];
+      snprintf(buffer, sizeof(buffer), "%.21Lg", real);
+      label.key = buffer;
+    }
+  }
+
+  return label;
+}
+
+bool label_order(const parsed_label & a, const parsed_label & b)
+{
+
+  /* Numeric labels sort by value before string labels, which sort lexicographically. */
+
+  if(a.numeric != b.numeric)
+  {
+    return a.numeric;
+  }
+
+  if(!a.numeric)
+  {
+    return a.key < b.key;
+  }
+
+  if(a.integral && b.integral)
+  {
+    return a.integer < b.integer;
+  }
+
+  return a.real < b.real;
+}
+
+std::vector<int> encode_labels(label_dictionary & dictionary, const std::vector<std::string> & cells)
+{
+
+  /* Returns the class index of every label cell. Labels not yet in the dictionary are appended in sorted order, so a dictionary built from the training file numbers its classes exactly as sorting the unique labels would. */
+
+  std::vector<int *> slots(cells.size());
+  std::vector<parsed_label> fresh;
+
+  for(size_t r = 0; r < cells.size(); r++)
+  {
+    parsed_label label = parse_label(cells[r]);
+    auto inserted = dictionary.indicies.emplace(label.key, -1);
+
+    if(inserted.second)
+    {
+      fresh.push_back(label);
+    }
+
+    // unordered_map nodes never move, so the slot stays valid while new labels are inserted
+
+    slots[r] = &inserted.first->second;
+  }
+
+  std::sort(fresh.begin(), fresh.end(), label_order);
+
+  for(auto & label : fresh)
+  {
+    dictionary.indicies[label.key] = dictionary.labels.size();
+    dictionary.labels.push_back(label.text);
+  }
+
+  std::vector<int> indicies(cells.size());
+
+  for(size_t r = 0; r < cells.size(); r++)
+  {
+    indicies[r] = *slots[r];
+  }
+
+  return indicies;
+}
+
+std::string decode_label(const label_dictionary & dictionary, int index)
+{
+
+  /* Returns the original label of a class index. */
+
+  if(index >= 0 && index < (int) dictionary.labels.size())
+  {
+    return dictionary.labels[index];
+  }
+
+  return std::to_string(index);
+}
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/nb_engine.h"
+#include "includes/discrete_naive_bayes.h"
+#include "includes/linear_naive_bayes.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+const int row_block = 256; // rows scored per matrix product, bounds the scores buffer to row_block x classes
+
+linear_model fit_tied_gaussian(const Eigen::MatrixXd & training, int training_size, int length, const std::vector<double> & weights)
+{
+
+  /* Fits Gaussian NB on columns 1 .. length - 1, with optional row weights, and pools the within class sums of squares of each feature, var_k = sum_y m2_yk / sum_y (n_yk - V2_yk / n_yk) with V2 the sum of squared weights (n_yk - 1 for unit weights), before expanding the model into linear weights. */
+
+  naive_bayes_engine<gaussian_distribution> engine;
+
+  for(int i = 1; i < length; i++)
+  {
+    engine.columns<0>().push_back(i);
+  }
+
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(training.col(0).head(training_size), classes);
+  engine.fit(training, training_size, classifications, classes.size(), weights);
+
+  const feature_group<gaussian_distribution> & group = std::get<0>(engine.groups);
+  int c = engine.classes;
+  int k_size = length - 1;
+
+  linear_model model;
+  model.classes = c;
+  model.weights.resize(c, k_size);
+  model.corrections.resize(c, k_size);
+  model.biases = Eigen::Map<Eigen::VectorXd>(engine.log_priors.data(), c);
+
+  for(int k = 0; k < k_size; k++)
+  {
+    double m2 = 0.0;
+    double dof = 0.0;
+
+    for(int y = 0; y < c; y++)
+    {
+      m2 += group.statistics[y * k_size + k].m2;
+      const gaussian_distribution::statistics & s = group.statistics[y * k_size + k];
+      dof += s.n > 0 ? s.n - s.squared_weights / s.n : 0.0;
+    }
+
+    double precision = dof > 0 && m2 > 0 ? dof / m2 : 1.0;
+
+    for(int y = 0; y < c; y++)
+    {
+      double mean = group.statistics[y * k_size + k].mean;
+      model.weights(y, k) = mean * precision;
+      model.corrections(y, k) = 0.5 * mean * mean * precision;
+      model.biases(y) -= model.corrections(y, k);
+    }
+  }
+
+  return model;
+}
+
+std::vector<int> linear_predict(const linear_model & model, const Eigen::MatrixXd & X, int size)
+{
+
+  /* Returns the argmax classification of each of the first size rows of X, whose features are columns 1 .. n, scoring row_block rows per matrix product. Blocks with missing (NaN) values score them as 0 and add back their corrections with a second product over the missing mask. */
+
+  int k_size = model.weights.cols();
+
+  std::vector<int> predictions;
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> scores;
+
+  for(int start = 0; start < size; start += row_block)
+  {
+    int rows = std::min(size - start, row_block);
+    auto block = X.block(start, 1, rows, k_size);
+
+    if(block.hasNaN())
+    {
+      Eigen::ArrayXXd observed = (block.array() == block.array()).cast<double>();
+      Eigen::MatrixXd values = (observed > 0).select(block.array(), 0.0).matrix();
+      scores = values * model.weights.transpose() + (1.0 - observed).matrix() * model.corrections.transpose();
+    } else
+    {
+      scores.noalias() = block * model.weights.transpose();
+    }
+    scores.rowwise() += model.biases.transpose();
+
+    for(int r = 0; r < rows; r++)
+    {
+      const double * row = scores.row(r).data();
+      predictions.push_back(std::max_element(row, row + model.classes) - row);
+    }
+  }
+
+  return predictions;
+}
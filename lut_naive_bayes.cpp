@@ -0,0 +1,163 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/nb_engine.h"
+#include "includes/discrete_naive_bayes.h"
+#include "includes/lut_naive_bayes.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+const double lut_floor = -100.0; // log likelihoods below this are clamped, e^-100 never decides an argmax in practice
+
+lut_model compile_lut(const Eigen::MatrixXd & training, int training_size, int length, int bins)
+{
+
+  /* Fits Gaussian NB, then compiles it into integer lookup tables: each feature is cut into equal frequency bins at the training quantiles, and each bin stores the fitted class log likelihood of the mean training value that falls in it, quantized to int16. Missing (NaN) training values are left out of the quantiles and the means. */
+
+  lut_model model;
+  model.bins = bins;
+
+  naive_bayes_engine<gaussian_distribution> engine;
+
+  for(int i = 0; i < length; i++)
+  {
+    model.columns.push_back(i);
+    if(i > 0)
+    {
+      engine.columns<0>().push_back(i);
+    }
+  }
+
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(training.col(0).head(training_size), classes);
+  engine.fit(training, training_size, classifications, classes.size());
+
+  const feature_group<gaussian_distribution> & group = std::get<0>(engine.groups);
+  int c = classes.size();
+  int k_size = length - 1;
+
+  model.classes = c;
+
+  std::vector<double> log_likelihoods((size_t) k_size * bins * c);
+  double max_abs = 0.0;
+
+  for(int k = 0; k < k_size; k++)
+  {
+    std::vector<double> values;
+    for(int r = 0; r < training_size; r++)
+    {
+      if(!std::isnan(training(r, k + 1)))
+      {
+        values.push_back(training(r, k + 1));
+      }
+    }
+    std::sort(values.begin(), values.end());
+
+    // a feature with no observed values gets all of its edges at 0
+
+    std::vector<double> edges;
+    for(int b = 1; b < bins; b++)
+    {
+      edges.push_back(values.empty() ? 0.0 : values[(size_t) b * values.size() / bins]);
+    }
+
+    // representative value of each bin is the mean of the training values it holds, or an edge for empty bins
+
+    std::vector<double> sums(bins, 0.0);
+    std::vector<double> counts(bins, 0.0);
+    for(auto v : values)
+    {
+      int bin = std::upper_bound(edges.begin(), edges.end(), v) - edges.begin();
+      sums[bin] += v;
+      counts[bin] += 1;
+    }
+
+    for(int b = 0; b < bins; b++)
+    {
+      double x = counts[b] > 0 ? sums[b] / counts[b] : edges[std::min(b, bins - 2)];
+
+      for(int y = 0; y < c; y++)
+      {
+        double l = std::max(group.distribution.log_likelihood(group.parameters[y * k_size + k], x), lut_floor);
+        log_likelihoods[((size_t) k * bins + b) * c + y] = l;
+        max_abs = std::max(max_abs, std::fabs(l));
+      }
+    }
+
+    model.edges.push_back(edges);
+  }
+
+  model.scale = max_abs > 0 ? 32767.0 / max_abs : 1.0;
+
+  for(auto l : log_likelihoods)
+  {
+    model.tables.push_back((int16_t) std::lround(l * model.scale));
+  }
+
+  for(int y = 0; y < c; y++)
+  {
+    model.biases.push_back((int32_t) std::lround(engine.log_priors[y] * model.scale));
+  }
+
+  return model;
+}
+
+template<typename Code> std::vector<int> lut_predict_codes(const lut_model & model, const Eigen::MatrixXd & X, int size)
+{
+
+  /* Encodes every row into bin codes, then scores it as a sum of int16 table gathers in an int32 accumulator. A missing (NaN) value is marginalised out by skipping its gather. */
+
+  int k_size = model.edges.size();
+  int c = model.classes;
+
+  std::vector<Code> codes(k_size);
+  std::vector<char> missing(k_size);
+  std::vector<int32_t> scores(c);
+  std::vector<int> predictions;
+
+  for(int r = 0; r < size; r++)
+  {
+    for(int k = 0; k < k_size; k++)
+    {
+      const std::vector<double> & edges = model.edges[k];
+      missing[k] = std::isnan(X(r, k + 1));
+      codes[k] = missing[k] ? 0 : (Code) (std::upper_bound(edges.begin(), edges.end(), X(r, k + 1)) - edges.begin());
+    }
+
+    std::copy(model.biases.begin(), model.biases.end(), scores.begin());
+
+    for(int k = 0; k < k_size; k++)
+    {
+      if(missing[k])
+      {
+        continue;
+      }
+      const int16_t * table = &model.tables[((size_t) k * model.bins + codes[k]) * c];
+      for(int y = 0; y < c; y++)
+      {
+        scores[y] += table[y];
+      }
+    }
+
+    predictions.push_back(std::max_element(scores.begin(), scores.end()) - scores.begin());
+  }
+
+  return predictions;
+}
+
+std::vector<int> lut_predict(const lut_model & model, const Eigen::MatrixXd & X, int size)
+{
+
+  /* Returns argmax classification predictions of a compiled lookup table model, whose features are columns 1 .. n of X. */
+
+  if(model.bins <= 256)
+  {
+    return lut_predict_codes<uint8_t>(model, X, size);
+  }
+
+  return lut_predict_codes<uint16_t>(model, X, size);
+}
@@ -4,44 +4,935 @@
 #include <vector>
 #include <map>
 #include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <chrono>
+#include <limits>
 #include "includes/eigen3/Eigen/Dense"
 #include "includes/utils.h"
 #include "includes/naive_bayes.h"
 #include "includes/kfcv.h"
+#include "includes/feature_selection.h"
+#include "includes/model.h"
+#include "includes/discrete_naive_bayes.h"
+#include "includes/mixed_naive_bayes.h"
+#include "includes/mips_naive_bayes.h"
+#include "includes/linear_naive_bayes.h"
+#include "includes/pca.h"
+#include "includes/em_naive_bayes.h"
+#include "includes/label_dictionary.h"
+#include "includes/categorical_dataset.h"
+#include "includes/quantile_sketch.h"
+#include "includes/sparse_naive_bayes.h"
 
 /* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
 
 
-template<typename T> T load_csv(const std::string & sys_path)
+bool missing_cell(const std::string & cell)
 {
 
-  /* Returns csv file input as an Eigen matrix or vector. */
+  /* Returns true for the cells that mark a missing value: an empty cell, NA, or ?. */
+
+  return cell.empty() || cell == "\r" || cell == "NA" || cell == "?";
+}
+
+double parse_cell(const std::string & cell)
+{
+
+  /* Parses one feature cell, where an empty cell, NA, or ? is a missing value and returned as NaN (as is NaN itself). */
+
+  if(missing_cell(cell))
+  {
+      return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  return std::stod(cell);
+}
+
+template<typename T> T load_csv(const std::string & sys_path, label_dictionary & dictionary)
+{
+
+  /* Returns csv file input as an Eigen matrix or vector, with the labels of the first column replaced by their class indicies in dictionary. */
 
   std::ifstream in;
   in.open(sys_path);
   std::string line;
-  std::vector<double> values;
+  std::vector<typename T::Scalar> values;
+  std::vector<std::string> label_cells;
+  std::vector<size_t> label_positions;
   uint rows = 0;
   while (std::getline(in, line)) {
       std::stringstream lineStream(line);
       std::string cell;
+      bool first = true;
       while (std::getline(lineStream, cell, ',')) {
-          values.push_back(std::stod(cell));
+          if(first) {
+              label_cells.push_back(cell);
+              label_positions.push_back(values.size());
+              values.push_back(0);
+              first = false;
+          } else {
+              values.push_back(parse_cell(cell));
+          }
+      }
+      if(!line.empty() && line.back() == ',') {
+          values.push_back(parse_cell(""));
       }
       rows = rows + 1;
   }
 
+  std::vector<int> indicies = encode_labels(dictionary, label_cells);
+  for(size_t r = 0; r < indicies.size(); r++)
+  {
+      values[label_positions[r]] = indicies[r];
+  }
+
   return Eigen::Map<const Eigen::Matrix<typename T::Scalar, T::RowsAtCompileTime, T::ColsAtCompileTime, Eigen::RowMajor>>(values.data(), rows, values.size()/rows);
 
   /* based on code from https://stackoverflow.com/questions/34247057/how-to-read-csv-file-and-assign-to-eigen-matrix/39146048 */
 }
 
-void driver(std::string sys_path_test, std::string sys_path_train, bool verbose, bool gaussian, bool categorical)
+struct cli_options
+{
+  bool verbose = false;
+  bool gaussian = false;
+  bool categorical = false;
+  bool multinomial = false;
+  bool complement = false;
+  bool bernoulli = false;
+  bool libsvm = false;
+  int bit_planes = 0;
+  std::string schema;
+  bool single_precision = false;
+  double rescore_margin = -1.0;
+  int lut_bins = 0;
+  int kde_grid = 0;
+  bool tied_variance = false;
+  int pca_components = 0;
+  std::string unlabeled_path;
+  em_options em;
+  int weight_column = 0;
+  bool prune_classes = false;
+  int top_classes = 0;
+  int probes = 0;
+  uint32_t hash_buckets = 0;
+  int discretize_bins = 0;
+  bool select = false;
+  bool backward = false;
+  bool prune = false;
+  int top_k = 0;
+  double min_score = -HUGE_VAL;
+  bool load = false;
+  std::string save_path;
+};
+
+template<typename T> T load_csv_columns(const std::string & sys_path, const std::vector<int> & columns, label_dictionary & dictionary)
+{
+
+  /* Returns the given (ascending) columns of a csv file as an Eigen matrix, without parsing the cells of any other column. Column 0 must be kept, its labels are replaced by their class indicies in dictionary. */
+
+  std::vector<bool> keep;
+  for(auto v : columns)
+  {
+    if(v >= (int) keep.size())
+    {
+      keep.resize(v + 1, false);
+    }
+    keep[v] = true;
+  }
+
+  std::ifstream in;
+  in.open(sys_path);
+  std::string line;
+  std::vector<typename T::Scalar> values;
+  std::vector<std::string> label_cells;
+  std::vector<size_t> label_positions;
+  uint rows = 0;
+  while (std::getline(in, line)) {
+      std::stringstream lineStream(line);
+      std::string cell;
+      size_t col = 0;
+      while (col < keep.size() && std::getline(lineStream, cell, ',')) {
+          if(col == 0) {
+              label_cells.push_back(cell);
+              label_positions.push_back(values.size());
+              values.push_back(0);
+          } else if(keep[col]) {
+              values.push_back(parse_cell(cell));
+          }
+          col++;
+      }
+      if(!line.empty() && line.back() == ',' && col < keep.size() && keep[col]) {
+          values.push_back(parse_cell(""));
+      }
+      rows = rows + 1;
+  }
+
+  std::vector<int> indicies = encode_labels(dictionary, label_cells);
+  for(size_t r = 0; r < indicies.size(); r++)
+  {
+      values[label_positions[r]] = indicies[r];
+  }
+
+  return Eigen::Map<const Eigen::Matrix<typename T::Scalar, T::RowsAtCompileTime, T::ColsAtCompileTime, Eigen::RowMajor>>(values.data(), rows, values.size()/rows);
+}
+
+SparseMatrixXd load_sparse_csv(const std::string & sys_path, Eigen::VectorXd & labels, label_dictionary & dictionary)
+{
+
+  /* Returns the feature columns of a csv file as a sparse matrix holding only its nonzero cells, with the class indicies of the first column returned in labels. Missing cells are left out like zeros. */
+
+  std::ifstream in;
+  in.open(sys_path);
+  std::string line;
+  std::vector<Eigen::Triplet<double>> triplets;
+  std::vector<std::string> label_cells;
+  int rows = 0;
+  int cols = 0;
+  while (std::getline(in, line)) {
+      std::stringstream lineStream(line);
+      std::string cell;
+      int col = 0;
+      while (std::getline(lineStream, cell, ',')) {
+          if(col == 0) {
+              label_cells.push_back(cell);
+          } else if(!missing_cell(cell)) {
+              double value = std::stod(cell);
+              if(value != 0.0) {
+                  triplets.push_back(Eigen::Triplet<double>(rows, col - 1, value));
+              }
+          }
+          col++;
+      }
+      cols = std::max(cols, col - 1);
+      rows = rows + 1;
+  }
+
+  std::vector<int> indicies = encode_labels(dictionary, label_cells);
+  labels = Eigen::Map<Eigen::VectorXi>(indicies.data(), indicies.size()).cast<double>();
+
+  SparseMatrixXd X(rows, cols);
+  X.setFromTriplets(triplets.begin(), triplets.end());
+  return X;
+}
+
+SparseMatrixXd load_libsvm(const std::string & sys_path, Eigen::VectorXd & labels, label_dictionary & dictionary, int cols, bool & parsed)
+{
+
+  /* Returns a LibSVM file, one "label index:value ..." row per line with 1 based feature indicies, as a sparse matrix with the class indicies of its labels returned in labels. A positive cols fixes the number of columns and drops the features beyond it, otherwise the largest index is used. A malformed index:value pair is reported with its line and parsed is set to false. */
+
+  std::ifstream in;
+  in.open(sys_path);
+  std::string line;
+  std::vector<Eigen::Triplet<double>> triplets;
+  std::vector<std::string> label_cells;
+  int rows = 0;
+  int max_index = 0;
+  int line_number = 0;
+  parsed = true;
+  while (std::getline(in, line)) {
+      line_number++;
+      line = line.substr(0, line.find('#'));
+      std::stringstream lineStream(line);
+      std::string token;
+      if(!(lineStream >> token)) {
+          continue;
+      }
+      label_cells.push_back(token);
+      while (lineStream >> token) {
+          const char * start = token.c_str();
+          char * end = nullptr;
+          errno = 0;
+          long index = strtol(start, &end, 10);
+          bool valid = end != start && *end == ':' && errno == 0 && index >= 1 && index <= INT_MAX;
+          double value = 0.0;
+          if(valid) {
+              const char * number = end + 1;
+              value = strtod(number, &end);
+              valid = end != number && *end == '\0' && errno == 0;
+          }
+          if(!valid) {
+              std::cout << "Malformed LibSVM entry \"" << token << "\" on line " << line_number << " of " << sys_path << "\n";
+              parsed = false;
+              return SparseMatrixXd();
+          }
+          if((cols <= 0 || index <= cols) && value != 0.0) {
+              triplets.push_back(Eigen::Triplet<double>(rows, index - 1, value));
+              max_index = std::max(max_index, (int) index);
+          }
+      }
+      rows = rows + 1;
+  }
+
+  std::vector<int> indicies = encode_labels(dictionary, label_cells);
+  labels = Eigen::Map<Eigen::VectorXi>(indicies.data(), indicies.size()).cast<double>();
+
+  SparseMatrixXd X(rows, cols > 0 ? cols : max_index);
+  X.setFromTriplets(triplets.begin(), triplets.end());
+  return X;
+}
+
+packed_rows load_packed_csv(const std::string & sys_path, Eigen::VectorXd & labels, label_dictionary & dictionary, int cols)
+{
+
+  /* Returns the feature columns of a csv file as bit packed binary rows, where every nonzero cell is a set bit and a missing cell is left unset, with the class indicies of the first column returned in labels. A positive cols fixes the number of columns and drops the features beyond it, otherwise the first row gives the width. */
+
+  std::ifstream in;
+  in.open(sys_path);
+  std::string line;
+  std::vector<std::string> label_cells;
+  packed_rows X;
+  while (std::getline(in, line)) {
+      std::stringstream lineStream(line);
+      std::string cell;
+      int col = 0;
+      if(X.rows == 0) {
+          X.cols = cols > 0 ? cols : std::count(line.begin(), line.end(), ',');
+          X.words = (X.cols + 63) / 64;
+      }
+      X.bits.resize((size_t) (X.rows + 1) * X.words, 0);
+      uint64_t * row = &X.bits[(size_t) X.rows * X.words];
+      while (std::getline(lineStream, cell, ',')) {
+          if(col == 0) {
+              label_cells.push_back(cell);
+          } else if(col <= X.cols && !missing_cell(cell) && std::stod(cell) != 0.0) {
+              row[(col - 1) / 64] |= (uint64_t) 1 << ((col - 1) % 64);
+          }
+          col++;
+      }
+      X.rows = X.rows + 1;
+  }
+
+  std::vector<int> indicies = encode_labels(dictionary, label_cells);
+  labels = Eigen::Map<Eigen::VectorXi>(indicies.data(), indicies.size()).cast<double>();
+
+  return X;
+}
+
+std::vector<column_codec> scan_codecs(const std::string & sys_path, bool & strings, int bins = 0, int weight_column = 0)
+{
+
+  /* Returns a codec for each feature column of a csv file that stores it raw when every cell is a non-negative integer, and sets strings when any cell is not a number. Missing cells are ignored. With bins, every other column whose cells are all numbers or missing is discretised into that many equal frequency bins, with edges from a quantile sketch built in the same pass, so the column is never held or sorted in full. A nonzero weight_column holds row weights and gets no codec. */
+
+  std::ifstream in;
+  in.open(sys_path);
+  std::string line;
+  std::vector<column_codec> codecs;
+  std::vector<quantile_sketch> sketches;
+  std::vector<bool> numeric;
+  strings = false;
+  while (std::getline(in, line)) {
+      std::stringstream lineStream(line);
+      std::string cell;
+      size_t col = 0;
+      while (std::getline(lineStream, cell, ',')) {
+          size_t f = col - 1 - (weight_column > 0 && (int) col > weight_column);
+          if(col > 0 && (int) col != weight_column) {
+              if(f >= codecs.size()) {
+                  codecs.resize(f + 1);
+                  sketches.resize(f + 1);
+                  numeric.resize(f + 1, true);
+              }
+              uint32_t code = 0;
+              bool missing = missing_cell(cell);
+              if(codecs[f].raw && !missing && !parse_code(cell, code)) {
+                  codecs[f].raw = false;
+              }
+              if(bins > 0 && numeric[f]) {
+                  char * end = nullptr;
+                  double value = strtod(cell.c_str(), &end);
+                  if(end != cell.c_str() && end[strspn(end, " \t\r")] == '\0') {
+                      if(value == value) {
+                          sketches[f].add(value);
+                      }
+                  } else if(!missing_cell(cell)) {
+                      numeric[f] = false;
+                  }
+              }
+              if(!codecs[f].raw && !strings && !missing) {
+                  char * end = nullptr;
+                  strtod(cell.c_str(), &end);
+                  strings = (end == cell.c_str() || end[strspn(end, " \t\r")] != '\0');
+              }
+          }
+          col++;
+      }
+  }
+
+  for(size_t j = 0; bins > 0 && j < codecs.size(); j++)
+  {
+      if(!codecs[j].raw && numeric[j])
+      {
+          codecs[j].edges = equal_frequency_edges(sketches[j], bins);
+      }
+  }
+
+  return codecs;
+}
+
+coded_dataset load_coded_csv(const std::string & sys_path, label_dictionary & dictionary, std::vector<column_codec> & codecs, int weight_column = 0)
+{
+
+  /* Returns a csv file of categorical features as integer codes. A missing cell gets code 0 in every column. Hashed, binned, and raw columns are parsed straight into codes, where a raw cell holding the integer v gets code v + 1 and one that is not a non-negative integer gets code 0, and the other cells of every other column are interned into their codec's dictionary. The labels of the first column are interned into dictionary, and a nonzero weight_column is read into the row weights. */
+
+  std::ifstream in;
+  in.open(sys_path);
+  std::string line;
+  std::vector<std::string> label_cells;
+  std::vector<std::vector<uint32_t>> codes(codecs.size());
+  std::vector<std::vector<std::string>> cells(codecs.size());
+  coded_dataset X;
+  while (std::getline(in, line)) {
+      std::stringstream lineStream(line);
+      std::string cell;
+      size_t col = 0;
+      size_t cols = codecs.size() + (weight_column > 0);
+      auto add_cell = [&](size_t col, const std::string & cell) {
+          size_t f = col - 1 - (weight_column > 0 && (int) col > weight_column);
+          if(col == 0) {
+              label_cells.push_back(cell);
+          } else if((int) col == weight_column) {
+              X.weights.push_back(parse_cell(cell));
+          } else if(missing_cell(cell)) {
+              codes[f].push_back(0);
+          } else if(codecs[f].buckets > 0) {
+              codes[f].push_back(hash_code(cell, codecs[f].buckets));
+          } else if(!codecs[f].edges.empty()) {
+              codes[f].push_back(bin_code(cell, codecs[f].edges));
+          } else if(codecs[f].raw) {
+              uint32_t code = 0;
+              codes[f].push_back(parse_code(cell, code) ? code + 1 : 0);
+          } else {
+              codes[f].push_back(1); // replaced by the cell's dictionary code once the column is interned
+              cells[f].push_back(cell);
+          }
+      };
+      while (std::getline(lineStream, cell, ',') && col <= cols) {
+          add_cell(col++, cell);
+      }
+
+      // short rows (such as a trailing empty cell, which getline drops) are padded with empty cells so every column stays aligned
+
+      while (col <= cols) {
+          add_cell(col++, "");
+      }
+      X.rows = X.rows + 1;
+  }
+
+  X.classifications = encode_labels(dictionary, label_cells);
+  X.columns.resize(codecs.size());
+
+  for(size_t j = 0; j < codecs.size(); j++)
+  {
+      if(!codecs[j].raw && codecs[j].buckets == 0 && codecs[j].edges.empty())
+      {
+          std::vector<int> indicies = encode_labels(codecs[j].values, cells[j]);
+          std::vector<std::string>().swap(cells[j]);
+          size_t next = 0;
+          for(auto & code : codes[j])
+          {
+              if(code != 0)
+              {
+                  code = indicies[next++] + 1;
+              }
+          }
+      }
+
+      set_codes(X.columns[j], codes[j]);
+      std::vector<uint32_t>().swap(codes[j]);
+  }
+
+  return X;
+}
+
+int csv_columns(const std::string & sys_path)
+{
+
+  /* Returns the number of cells in the first line of a csv file. */
+
+  std::ifstream in(sys_path);
+  std::string line;
+  std::getline(in, line);
+
+  return std::count(line.begin(), line.end(), ',') + 1;
+}
+
+bool valid_weights(const std::vector<double> & weights)
+{
+
+  /* Returns true when every row weight is a non-negative number, printing the first bad row otherwise. */
+
+  for(size_t r = 0; r < weights.size(); r++)
+  {
+	if(!(weights[r] >= 0))
+	{
+		std::cout << "Invalid row weight in row " << r << ": weights must be non-negative numbers\n";
+		return false;
+	}
+  }
+
+  return true;
+}
+
+void print_predictions(std::vector<int> predictions, bool verbose, bool gaussian, const label_dictionary & dictionary)
+{
+
+  /* Prints predicted classifications in their original labels, one row per line. */
+
+  int count = 0;
+  for(auto v : predictions)
+  {
+	if(verbose == true || gaussian == false)
+	{
+		std::cout << "Row " << count << ": Class = " << decode_label(dictionary, v) << "\n";
+	} else
+	{
+		std::cout << decode_label(dictionary, v) << "\n";
+	}
+	count++;
+  }
+  std::cout << "\n";
+}
+
+void model_driver(std::string sys_path_test, std::string sys_path_model, cli_options options)
+{
+
+  /* Driver that classifies test data with a model saved by a previous run, parsing only the columns the model uses. */
+
+  std::vector<int> columns;
+  std::vector<int> predictions;
+  label_dictionary dictionary;
+
+  if(model_type(sys_path_model) == "gaussian")
+  {
+	pca_projection projection;
+	naive_bayes_engine<gaussian_distribution> engine = load_gaussian_model(sys_path_model, columns, dictionary, projection);
+	Eigen::MatrixXd test = load_csv_columns<Eigen::MatrixXd>(sys_path_test, columns, dictionary);
+
+	if(projection.components.size() > 0)
+	{
+		test = apply_pca(projection, test, test.rows());
+	}
+
+	predictions = gaussian_engine_predict(engine, test, test.rows(), options.verbose);
+
+	print_predictions(predictions, options.verbose, true, dictionary);
+  } else if(model_type(sys_path_model) == "categorical")
+  {
+	naive_bayes_engine<categorical_distribution> engine = load_categorical_model(sys_path_model, columns, dictionary);
+	Eigen::MatrixXd test = load_csv_columns<Eigen::MatrixXd>(sys_path_test, columns, dictionary);
+
+	predictions = engine.predict(test, test.rows());
+
+	print_predictions(predictions, options.verbose, false, dictionary);
+  } else if(model_type(sys_path_model) == "lut")
+  {
+	pca_projection projection;
+	lut_model model = load_lut_model(sys_path_model, dictionary, projection);
+	Eigen::MatrixXd test = load_csv_columns<Eigen::MatrixXd>(sys_path_test, model.columns, dictionary);
+
+	if(projection.components.size() > 0)
+	{
+		test = apply_pca(projection, test, test.rows());
+	}
+
+	predictions = lut_predict(model, test, test.rows());
+
+	print_predictions(predictions, options.verbose, true, dictionary);
+  } else if(model_type(sys_path_model) == "coded_categorical")
+  {
+	std::vector<column_codec> codecs;
+	int weight_column = 0;
+	coded_categorical_model model = load_coded_categorical_model(sys_path_model, codecs, dictionary, weight_column);
+
+	if(options.weight_column > 0 && options.weight_column != weight_column)
+	{
+		std::cout << "--weight-column " << options.weight_column << " does not match the weight column " << weight_column << " the model was fit with\n";
+		return;
+	}
+
+	coded_dataset test = load_coded_csv(sys_path_test, dictionary, codecs, weight_column);
+
+	predictions = coded_categorical_predict(model, test);
+
+	print_predictions(predictions, options.verbose, false, dictionary);
+  } else
+  {
+	std::cout << "Unknown model type in: " << sys_path_model << "\n";
+  }
+}
+
+bool codable(const std::string & sys_path, cli_options options)
+{
+
+  /* Returns true when -c should run on compact integer codes: always for files with string features, which only the codes can hold, and for files whose features are all non-negative integers or are discretised unless feature selection or pruning needs the dense matrix. */
+
+  bool strings = false;
+  std::vector<column_codec> codecs = scan_codecs(sys_path, strings, 0, options.weight_column);
+
+  if(strings)
+  {
+	return true;
+  }
+
+  if(options.select || options.prune)
+  {
+	return false;
+  }
+
+  if(options.hash_buckets > 0 || options.discretize_bins > 0)
+  {
+	return true;
+  }
+
+  for(auto & codec : codecs)
+  {
+	if(!codec.raw)
+	{
+		return false;
+	}
+  }
+
+  return true;
+}
+
+void coded_driver(std::string sys_path_test, std::string sys_path_train, cli_options options)
+{
+
+  /* Driver for Categorical NB on compact integer codes, for csv files whose feature columns are non-negative integers, hold strings, or are discretised continuous values. */
+
+  double alpha = 1.0;
+
+  label_dictionary dictionary;
+  bool strings = false;
+  std::vector<column_codec> codecs = scan_codecs(sys_path_train, strings, options.discretize_bins, options.weight_column);
+  for(auto & codec : codecs)
+  {
+	codec.buckets = options.hash_buckets;
+  }
+  coded_dataset train = load_coded_csv(sys_path_train, dictionary, codecs, options.weight_column);
+
+  if(!valid_weights(train.weights))
+  {
+	return;
+  }
+
+  coded_categorical_model model = fit_coded_categorical(train, dictionary.labels.size(), alpha);
+
+  // saved before the test file can add its unseen values to the dictionaries
+
+  if(!options.save_path.empty())
+  {
+	save_coded_categorical_model(options.save_path, model, codecs, dictionary, options.weight_column);
+  }
+
+  coded_dataset test = load_coded_csv(sys_path_test, dictionary, codecs, options.weight_column);
+
+  if(options.verbose == true)
+  {
+	std::cout << "Train Data: " << sys_path_train << " (" << train.rows << " x " << train.columns.size() << ", " << coded_bytes(train) << " bytes of codes, " << (size_t) train.rows * train.columns.size() * sizeof(double) << " as doubles)\n";
+	std::cout << "Test Data: " << sys_path_test << " (" << test.rows << " x " << test.columns.size() << ", " << coded_bytes(test) << " bytes of codes, " << (size_t) test.rows * test.columns.size() * sizeof(double) << " as doubles)\n\n";
+  }
+
+  std::vector<int> predictions = coded_categorical_predict(model, test);
+  print_predictions(predictions, options.verbose, false, dictionary);
+
+  if(options.verbose)
+  {
+	printf("model performance on new data: %f\n",misclassification_rate(predictions,test.classifications));
+  }
+}
+
+void sparse_driver(std::string sys_path_test, std::string sys_path_train, cli_options options)
+{
+
+  /* Driver for the classifiers that train and score on sparse data, read from csv or LibSVM files. */
+
+  label_dictionary dictionary;
+  double alpha = 1.0;
+  double var_smoothing = 1e-9;
+
+  Eigen::VectorXd train_labels;
+  Eigen::VectorXd test_labels;
+  bool parsed = true;
+  SparseMatrixXd train = options.libsvm ? load_libsvm(sys_path_train, train_labels, dictionary, 0, parsed) : load_sparse_csv(sys_path_train, train_labels, dictionary);
+  if(!parsed)
+  {
+	return;
+  }
+  SparseMatrixXd test = options.libsvm ? load_libsvm(sys_path_test, test_labels, dictionary, train.cols(), parsed) : load_sparse_csv(sys_path_test, test_labels, dictionary);
+  if(!parsed)
+  {
+	return;
+  }
+
+  if(options.verbose == true)
+  {
+	std::cout << "Train Data: " << sys_path_train << " (" << train.rows() << " x " << train.cols() << ", " << train.nonZeros() << " nonzeros)\n";
+	std::cout << "Test Data: " << sys_path_test << " (" << test.rows() << " x " << test.cols() << ", " << test.nonZeros() << " nonzeros)\n\n";
+  }
+
+  test.conservativeResize(test.rows(), train.cols());
+
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(train_labels, classes);
+
+  if(options.gaussian)
+  {
+	sparse_gaussian_model model = fit_sparse_gaussian(train, classifications, classes.size(), var_smoothing);
+	std::vector<int> predictions = argmax_rows(sparse_gaussian_scores(model, test));
+	print_predictions(predictions, options.verbose, true, dictionary);
+
+	if(options.verbose)
+	{
+		std::vector<int> truth_labels = class_indicies_by_label(test_labels, classes);
+		printf("model performance on new data: %f\n",misclassification_rate(predictions,truth_labels));
+	}
+	return;
+  }
+
+  count_table counts = count_by_classification(train, classifications, classes.size());
+
+  multinomial_model model = options.complement ? fit_complement(counts, alpha, true) : fit_multinomial(counts, alpha);
+  std::vector<int> predictions = argmax_rows(multinomial_scores(model, test));
+  print_predictions(predictions, options.verbose, false, dictionary);
+
+  // scored against the test labels rather than cross validated, which would need the sparse test matrix densified
+
+  if(options.verbose)
+  {
+	std::vector<int> truth_labels = class_indicies_by_label(test_labels, classes);
+	printf("model performance on new data: %f\n",misclassification_rate(predictions,truth_labels));
+  }
+}
+
+void bernoulli_driver(std::string sys_path_test, std::string sys_path_train, cli_options options)
+{
+
+  /* Driver for Bernoulli NB on bit packed binary data. */
+
+  label_dictionary dictionary;
+  double alpha = 1.0;
+
+  Eigen::VectorXd train_labels;
+  Eigen::VectorXd test_labels;
+  packed_rows train = load_packed_csv(sys_path_train, train_labels, dictionary, 0);
+  packed_rows test = load_packed_csv(sys_path_test, test_labels, dictionary, train.cols);
+
+  if(options.verbose == true)
+  {
+	std::cout << "Train Data: " << sys_path_train << " (" << train.rows << " x " << train.cols << ", " << train.words << " words per row)\n";
+	std::cout << "Test Data: " << sys_path_test << " (" << test.rows << " x " << test.cols << ", " << test.words << " words per row)\n\n";
+  }
+
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(train_labels, classes);
+  count_table counts = count_by_classification(train, classifications, classes.size());
+
+  bernoulli_model model = fit_bernoulli(counts, alpha);
+
+  if(options.bit_planes > 0)
+  {
+	quantize_bernoulli(model, options.bit_planes, train.words);
+  }
+
+  std::vector<int> predictions = argmax_rows(bernoulli_scores(model, test));
+  print_predictions(predictions, options.verbose, false, dictionary);
+
+  if(options.verbose)
+  {
+	int num_folds = 10;
+	Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(test.rows, test.cols + 1);
+	dense.col(0) = test_labels;
+	for(int r = 0; r < test.rows; r++)
+	{
+		for(int j = 0; j < test.cols; j++)
+		{
+			dense(r, j + 1) = (test.bits[(size_t) r * test.words + j / 64] >> (j % 64)) & 1;
+		}
+	}
+	double result = kfcv(dense,num_folds,&bernoulli_naive_bayes_classifier,options.verbose);
+	printf("\nmodel performance on new data: %f\n",result);
+  }
+}
+
+void mixed_driver(std::string sys_path_test, std::string sys_path_train, cli_options options)
+{
+
+  /* Driver for a mixed model whose columns each follow the distribution given by the schema. */
+
+  label_dictionary dictionary;
+  double alpha = 1.0;
+
+  Eigen::MatrixXd train = load_csv<Eigen::MatrixXd>(sys_path_train, dictionary);
+  Eigen::MatrixXd test = load_csv<Eigen::MatrixXd>(sys_path_test, dictionary);
+  bool parsed = true;
+  std::vector<column_type> schema = parse_schema(options.schema, parsed);
+
+  if(!parsed)
+  {
+	return;
+  }
+
+  if(schema.size() != (size_t) train.cols() - 1)
+  {
+	std::cout << "Schema has " << schema.size() << " columns but the data has " << train.cols() - 1 << " feature columns\n";
+	return;
+  }
+
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(train.col(0), classes);
+
+  mixed_model model = fit_mixed(train, classifications, classes.size(), schema, alpha);
+
+  if(options.verbose == true)
+  {
+	std::cout << "Mixed model: " << model.columns<0>().size() << " gaussian, " << model.columns<1>().size() << " categorical, " << model.columns<2>().size() << " bernoulli columns\n\n";
+  }
+
+  std::vector<int> predictions = model.predict(test, test.rows());
+  print_predictions(predictions, options.verbose, false, dictionary);
+
+  if(options.verbose)
+  {
+	std::vector<int> truth_labels = class_indicies_by_label(test.col(0), classes);
+	printf("model performance on new data: %f\n",misclassification_rate(predictions,truth_labels));
+  }
+}
+
+void float_driver(std::string sys_path_test, std::string sys_path_train, cli_options options)
+{
+
+  /* Driver that loads, fits, and scores in single precision. In verbose mode the double precision path is run on the same data and the two are compared. */
+
+  label_dictionary dictionary;
+  std::vector<int> (*float_classifier) (Eigen::MatrixXf, int, Eigen::MatrixXf, int, int, bool) = &gaussian_naive_bayes_classifier;
+  std::vector<int> (*double_classifier) (Eigen::MatrixXd, int, Eigen::MatrixXd, int, int, bool) = &gaussian_naive_bayes_classifier;
+
+  if(options.categorical)
+  {
+	float_classifier = &categorical_naive_bayes_classifier;
+	double_classifier = &categorical_naive_bayes_classifier;
+  }
+
+  Eigen::MatrixXf train = load_csv<Eigen::MatrixXf>(sys_path_train, dictionary);
+  Eigen::MatrixXf test = load_csv<Eigen::MatrixXf>(sys_path_test, dictionary);
+
+  std::vector<int> predictions = float_classifier(test, test.rows(), train, train.rows(), train.cols(), false);
+  print_predictions(predictions, options.verbose, options.gaussian, dictionary);
+
+  if(options.verbose)
+  {
+	Eigen::MatrixXd train_double = load_csv<Eigen::MatrixXd>(sys_path_train, dictionary);
+	Eigen::MatrixXd test_double = load_csv<Eigen::MatrixXd>(sys_path_test, dictionary);
+	std::vector<int> double_predictions = double_classifier(test_double, test_double.rows(), train_double, train_double.rows(), train_double.cols(), false);
+
+	std::vector<double> classes;
+	class_indicies_by_label(train_double.col(0), classes);
+	std::vector<int> truth_labels = class_indicies_by_label(test_double.col(0), classes);
+
+	printf("float32 vs float64 report: %s\n", sys_path_test.c_str());
+	printf("  dataset bytes:              float32 %lu, float64 %lu\n", (unsigned long) (test.size() + train.size()) * sizeof(float), (unsigned long) (test_double.size() + train_double.size()) * sizeof(double));
+	printf("  prediction agreement:       %f\n", 1.0 - misclassification_rate(predictions, double_predictions));
+	printf("  misclassification float32:  %f\n", misclassification_rate(predictions, truth_labels));
+	printf("  misclassification float64:  %f\n", misclassification_rate(double_predictions, truth_labels));
+  }
+}
+
+void driver(std::string sys_path_test, std::string sys_path_train, cli_options options)
 {
 
   /* Driver for a naive bayes classifier example. */
 
-  Eigen::MatrixXd test = load_csv<Eigen::MatrixXd>(sys_path_test);
+  label_dictionary dictionary;
+  bool verbose = options.verbose;
+  bool gaussian = options.gaussian;
+  bool categorical = options.categorical;
+
+  Eigen::MatrixXd train = load_csv<Eigen::MatrixXd>(sys_path_train, dictionary);
+
+  // columns of the dataset the model is fit on, column 0 is the classification
+
+  std::vector<int> columns;
+  for(int i = 0; i < train.cols(); i++)
+  {
+	columns.push_back(i);
+  }
+
+  // the weight column is split off the features, and left out of the columns parsed from the test file
+
+  std::vector<double> weights;
+  if(options.weight_column > 0)
+  {
+	weights.assign(train.col(options.weight_column).data(), train.col(options.weight_column).data() + train.rows());
+	columns.erase(columns.begin() + options.weight_column);
+
+	if(!valid_weights(weights))
+	{
+		return;
+	}
+
+	train = select_columns(train, std::vector<int>(columns.begin() + 1, columns.end()));
+  }
+
+  if(options.prune == true)
+  {
+	std::vector<double> scores = gaussian ? gaussian_feature_scores(train, train.rows(), train.cols()) : categorical_feature_scores(train, train.rows(), train.cols());
+	std::vector<int> kept = prune_features(scores, options.top_k, options.min_score, verbose);
+
+	std::vector<int> dataset_columns(1, 0);
+	for(auto v : kept)
+	{
+		dataset_columns.push_back(columns[v]);
+	}
+
+	train = select_columns(train, kept);
+	columns = dataset_columns;
+  }
+
+  if(options.select == true)
+  {
+	int num_folds = 10;
+	std::vector<int> selected = wrapper_feature_selection(train, num_folds, gaussian ? &gaussian_contribution_cache : &categorical_contribution_cache, options.backward, verbose);
+
+	std::vector<int> kept(1, 0);
+	for(auto v : selected)
+	{
+		kept.push_back(columns[v]);
+	}
+
+	train = select_columns(train, selected);
+	columns = kept;
+  }
+
+  if(options.prune == true || options.select == true)
+  {
+	std::cout << "Selected columns:";
+	for(size_t i = 1; i < columns.size(); i++)
+	{
+		std::cout << " " << columns[i];
+	}
+	std::cout << "\n\n";
+  }
+
+  Eigen::MatrixXd test = load_csv_columns<Eigen::MatrixXd>(sys_path_test, columns, dictionary);
+
+  // the PCA stage replaces the feature columns of both files by their whitened component scores, ahead of any -g model
+
+  pca_projection projection;
+  if(gaussian == true && options.pca_components > 0)
+  {
+	projection = fit_pca(train, train.rows(), train.cols(), options.pca_components);
+	train = apply_pca(projection, train, train.rows());
+	test = apply_pca(projection, test, test.rows());
+
+	if(verbose == true)
+	{
+		std::cout << "PCA: kept " << projection.components.cols() << " of " << projection.components.rows() << " features, component variances " << projection.variances.transpose() << "\n\n";
+	}
+  }
 
   if(verbose == true)
   {
@@ -49,32 +940,165 @@ void driver(std::string sys_path_test, std::string sys_path_train, bool verbose,
       std::cout << test << "\n\n";
   }
 
-  Eigen::MatrixXd train = load_csv<Eigen::MatrixXd>(sys_path_train);
-
   if(verbose == true)
   {
       std::cout << "Train Data: " << sys_path_train << "\n";
       std::cout << train << "\n\n";
   }
 
-  if(gaussian == true)
+  if(gaussian == true && options.lut_bins > 0)
   {
-  	std::vector<int> predictions = gaussian_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(),verbose);
-  	
-    	int count = 0;
-    	for(auto v : predictions)
-    	{
-        	if(verbose == true)
+	lut_model model = compile_lut(train, train.rows(), train.cols(), options.lut_bins);
+	model.columns = columns;
+
+	std::vector<int> predictions = lut_predict(model, test, test.rows());
+	print_predictions(predictions, verbose, true, dictionary);
+
+	if(!options.save_path.empty())
+	{
+		save_lut_model(options.save_path, model, dictionary, options.pca_components > 0 ? &projection : nullptr);
+	}
+
+	std::vector<int> exact_predictions = gaussian_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(), false);
+	printf("lookup table: %d bins (%s codes), %lu table bytes, agreement with gaussian_pdf scoring: %f\n", model.bins, model.bins <= 256 ? "uint8" : "uint16", (unsigned long) model.tables.size() * sizeof(int16_t), 1.0 - misclassification_rate(predictions, exact_predictions));
+  } else if(gaussian == true && options.kde_grid > 0)
+  {
+	std::vector<int> predictions = kde_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(), options.kde_grid, weights);
+	print_predictions(predictions, verbose, true, dictionary);
+
+	if(verbose)
+	{
+		std::vector<int> labels(test.col(0).data(), test.col(0).data() + test.rows());
+		std::vector<int> gaussian_predictions = gaussian_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(), false);
+		printf("misclassification rate: %f kernel density, %f gaussian_pdf\n", misclassification_rate(predictions, labels), misclassification_rate(gaussian_predictions, labels));
+	}
+  } else if(gaussian == true && !options.unlabeled_path.empty())
+  {
+	options.em.verbose = verbose;
+	em_model model = fit_semi_supervised_em(train, train.rows(), columns, options.unlabeled_path, options.em);
+	std::vector<int> predictions = em_predict(model, test, test.rows());
+	print_predictions(predictions, verbose, true, dictionary);
+
+	if(!options.save_path.empty())
+	{
+		// saved as a Gaussian model, so it loads without the unlabeled file
+
+		save_gaussian_model(options.save_path, gaussian_engine_from_moments(model.means, model.standard_deviations, model.log_priors), columns, dictionary);
+	}
+
+	if(verbose)
+	{
+		std::vector<int> labels(test.col(0).data(), test.col(0).data() + test.rows());
+		std::vector<int> supervised_predictions = gaussian_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(), false);
+		printf("misclassification rate: %f with EM, %f labeled rows only\n", misclassification_rate(predictions, labels), misclassification_rate(supervised_predictions, labels));
+	}
+  } else if(gaussian == true && options.tied_variance)
+  {
+	linear_model model = fit_tied_gaussian(train, train.rows(), train.cols(), weights);
+	std::vector<int> predictions = linear_predict(model, test, test.rows());
+	print_predictions(predictions, verbose, true, dictionary);
+
+	if(verbose)
+	{
+		std::vector<int> quadratic_predictions = gaussian_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(), false);
+		printf("agreement with per class variances: %f\n", 1.0 - misclassification_rate(predictions, quadratic_predictions));
+	}
+  } else if(gaussian == true && options.top_classes > 0)
+  {
+	naive_bayes_engine<gaussian_distribution> engine = fit_gaussian_engine(train, train.rows(), train.cols());
+
+	int k = options.top_classes;
+	int num_lists = std::max(1, (int) std::lround(sqrt((double) engine.classes)));
+	int probes = options.probes > 0 ? options.probes : std::max(1, num_lists / 10);
+
+	auto start = std::chrono::steady_clock::now();
+	mips_index index = build_mips_index(gaussian_inner_product_weights(engine), num_lists, 20);
+	auto built = std::chrono::steady_clock::now();
+
+	Eigen::MatrixXd queries = augment_queries(test, test.rows(), engine.columns<0>());
+	std::vector<std::vector<int>> top = mips_top_k(index, queries, k, probes);
+	auto searched = std::chrono::steady_clock::now();
+	std::vector<std::vector<int>> exact = exhaustive_top_k(index.weights, queries, k);
+	auto scanned = std::chrono::steady_clock::now();
+
+	std::vector<int> predictions;
+	for(auto v : top)
+	{
+		predictions.push_back(v[0]);
+	}
+	print_predictions(predictions, verbose, true, dictionary);
+
+	if(verbose)
+	{
+		for(size_t r = 0; r < top.size(); r++)
 		{
-			std::cout << "Row " << count << ": Class = " << v << "\n";
-		} else
+			std::cout << "top " << k << " classes of row " << r << ":";
+			for(auto v : top[r])
+			{
+				std::cout << " " << decode_label(dictionary, v);
+			}
+			std::cout << "\n";
+		}
+		std::cout << "\n";
+	}
+
+	long found = 0;
+	long expected = 0;
+	long top_one = 0;
+	for(size_t r = 0; r < top.size(); r++)
+	{
+		for(auto v : exact[r])
 		{
-			std::cout << v << "\n";
+			found += std::find(top[r].begin(), top[r].end(), v) != top[r].end();
 		}
-		count++;
-    	}
-    	std::cout << "\n";
-  	
+		expected += exact[r].size();
+		top_one += (top[r][0] == exact[r][0]);
+	}
+
+	auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+	printf("inner product index: %d classes in %d lists, %d probed\n", engine.classes, (int) index.lists.size(), std::min(probes, (int) index.lists.size()));
+	printf("  build:              %f ms\n", ms(start, built));
+	printf("  index top %d:       %f ms\n", k, ms(built, searched));
+	printf("  exhaustive top %d:  %f ms\n", k, ms(searched, scanned));
+	printf("  recall at %d:       %f\n", k, expected ? (double) found / expected : 0.0);
+	printf("  top 1 agreement:    %f\n", top.empty() ? 0.0 : (double) top_one / top.size());
+  } else if(gaussian == true && options.prune_classes)
+  {
+	pruning_counters counters;
+	std::vector<int> predictions = gaussian_pruned_classifier(test, test.rows(), train, train.rows(), train.cols(), counters);
+	print_predictions(predictions, verbose, true, dictionary);
+
+	printf("evaluated %ld of %ld feature likelihoods (%f)\n", counters.evaluations, counters.full_evaluations, counters.full_evaluations ? (double) counters.evaluations / counters.full_evaluations : 0.0);
+
+	if(verbose)
+	{
+		std::vector<int> full_predictions = gaussian_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(), false);
+		printf("agreement with full scan: %f\n", 1.0 - misclassification_rate(predictions, full_predictions));
+	}
+  } else if(gaussian == true && options.rescore_margin >= 0)
+  {
+	rescoring_counters counters;
+	std::vector<int> predictions = gaussian_rescored_classifier(test, test.rows(), train, train.rows(), train.cols(), options.rescore_margin, counters);
+	print_predictions(predictions, verbose, true, dictionary);
+
+	printf("rescored %ld of %ld rows (%f) in double precision, %ld changed\n", counters.rescored, counters.rows, counters.rows ? (double) counters.rescored / counters.rows : 0.0, counters.changed);
+
+	if(verbose)
+	{
+		std::vector<int> double_predictions = gaussian_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(), false);
+		printf("agreement with double precision: %f\n", 1.0 - misclassification_rate(predictions, double_predictions));
+	}
+  } else if(gaussian == true)
+  {
+  	std::vector<int> predictions = gaussian_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(), verbose, weights);
+  	print_predictions(predictions, verbose, true, dictionary);
+
+	if(!options.save_path.empty())
+	{
+		naive_bayes_engine<gaussian_distribution> engine = fit_gaussian_engine(train, train.rows(), train.cols(), weights);
+		save_gaussian_model(options.save_path, engine, columns, dictionary, options.pca_components > 0 ? &projection : nullptr);
+	}
 
   	if(verbose)
   	{
@@ -85,14 +1109,14 @@ void driver(std::string sys_path_test, std::string sys_path_train, bool verbose,
 
   } else if(categorical == true)
   {
-	std::vector<int> predictions = categorical_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(), verbose);
-	int count = 0;
-    	for(auto v : predictions)
-    	{
-        	std::cout << "Row " << count << ": Class = " << v << "\n"; // add back after debugging
-        	count++;
-    	}
-    	std::cout << "\n";
+	std::vector<int> predictions = categorical_naive_bayes_classifier(test, test.rows(), train, train.rows(), train.cols(), verbose, weights);
+	print_predictions(predictions, verbose, false, dictionary);
+
+	if(!options.save_path.empty())
+	{
+		naive_bayes_engine<categorical_distribution> engine = fit_categorical_engine(train, train.rows(), train.cols(), 1.0, weights);
+		save_categorical_model(options.save_path, engine, columns, dictionary);
+	}
 
   	if(verbose)
   	{
@@ -106,9 +1130,7 @@ void driver(std::string sys_path_test, std::string sys_path_train, bool verbose,
 int main(int argc, char ** argv)
 {
 	
-  bool verbose = false;
-  bool gaussian = false;
-  bool categorical = false;
+  cli_options options;
 
   if(argc == 1)
   {
@@ -131,7 +1153,34 @@ int main(int argc, char ** argv)
       std::cout << "   -h     Displays help menu\n";
       std::cout << "   -v     Displays output in verbose mode\n";
       std::cout << "   -g     Gaussian Naive Bayes\n";
-      std::cout << "   -c     Categorical Naive Bayes\n";
+      std::cout << "   -c     Categorical Naive Bayes (string valued features are dictionary encoded)\n";
+      std::cout << "   --hash-buckets [n]  Hash -c feature values into n buckets per column to bound memory\n";
+      std::cout << "   --discretize [n]   Cut continuous -c features into n equal frequency bins from a streaming quantile sketch\n";
+      std::cout << "   -m     Multinomial Naive Bayes on sparse count data\n";
+      std::cout << "   --complement  Use Complement Naive Bayes with -m for imbalanced classes\n";
+      std::cout << "   --libsvm     Read [train] and [test] as sparse LibSVM files, for -g or -m\n";
+      std::cout << "   -b     Bernoulli Naive Bayes on bit packed binary data\n";
+      std::cout << "   --schema [types]   Mixed Naive Bayes with one of g, c, b, or i (ignored) per feature column, inline or in a file\n";
+      std::cout << "   --float            Load, fit, and score -g or -c in single precision (with -v, compares against double)\n";
+      std::cout << "   --rescore-margin [m]  Score -g in float and rescore in double rows whose top two log scores are within m\n";
+      std::cout << "   --lut-bins [n]     Score -g with int16 lookup tables over n quantile bins per feature, reporting agreement with exact scoring\n";
+      std::cout << "   --kde [n]          Score -g with kernel density estimates tabulated on n grid points per class and feature\n";
+      std::cout << "   --tied-variance    Pool -g variances over the classes and score with one matrix product per block of rows\n";
+      std::cout << "   --pca [k]          Fit -g on the top k whitened principal components of the features\n";
+      std::cout << "   --unlabeled [csv]  Semi-supervised -g, refining the model by EM over an unlabeled csv file streamed in chunks\n";
+      std::cout << "   --em-tolerance [x] Stop EM once the log likelihood improves by less than this fraction (default 1e-6)\n";
+      std::cout << "   --em-iterations [n] Most EM iterations to run (default 100)\n";
+      std::cout << "   --prune-classes    Exact -g argmax that drops classes which can no longer win, for models with many classes\n";
+      std::cout << "   --top-classes [k]  Approximate top k -g classes from an inner product index, benchmarked against exhaustive scoring\n";
+      std::cout << "   --probes [n]       Index lists searched with --top-classes, more probes give higher recall\n";
+      std::cout << "   --weight-column [j]  Read csv column j as row weights for -g, -c, --kde, or --tied-variance (the test file keeps the same layout)\n";
+      std::cout << "   -s     Wrapper feature selection with cross validation before classifying\n";
+      std::cout << "   --backward  Use backward elimination instead of forward selection with -s\n";
+      std::cout << "   --top-k [n]        Keep only the n features with the best class separability score\n";
+      std::cout << "   --min-score [x]    Drop features with a class separability score below x\n";
+      std::cout << "   --save [model]     Save the fitted -g, -c, --lut-bins, or --unlabeled model to a file\n";
+      std::cout << "   --load             Treat [train] as a model saved with --save\n";
+      std::cout << "   --quantize [bits]  Score -b with popcounts over log odds quantized to the given bits\n";
       return 0;
     } else if(counter == 1 && !(valid_filepath(argv[1])))
     {
@@ -154,13 +1203,112 @@ int main(int argc, char ** argv)
 
       if(argv[counter][0] == '-' && argv[counter][1] == 'v' && argv[counter][2] == '\0')
       {
-        verbose = true;
+        options.verbose = true;
       } else if(argv[counter][0] == '-' && argv[counter][1] == 'g' && argv[counter][2] == '\0')
       {
-	gaussian = true;
+	options.gaussian = true;
       } else if(argv[counter][0] == '-' && argv[counter][1] == 'c' && argv[counter][2] == '\0')
       {
-      	categorical = true;
+      	options.categorical = true;
+      } else if(argv[counter][0] == '-' && argv[counter][1] == 'm' && argv[counter][2] == '\0')
+      {
+      	options.multinomial = true;
+      } else if(argv[counter][0] == '-' && argv[counter][1] == 'b' && argv[counter][2] == '\0')
+      {
+      	options.bernoulli = true;
+      } else if(argv[counter][0] == '-' && argv[counter][1] == 's' && argv[counter][2] == '\0')
+      {
+      	options.select = true;
+      } else if(std::string(argv[counter]) == "--complement")
+      {
+      	options.multinomial = true;
+      	options.complement = true;
+      } else if(std::string(argv[counter]) == "--backward")
+      {
+      	options.backward = true;
+      } else if(std::string(argv[counter]) == "--top-k" && counter + 1 < argc)
+      {
+      	options.prune = true;
+      	options.top_k = atoi(argv[++counter]);
+      } else if(std::string(argv[counter]) == "--min-score" && counter + 1 < argc)
+      {
+      	options.prune = true;
+      	options.min_score = atof(argv[++counter]);
+      } else if(std::string(argv[counter]) == "--save" && counter + 1 < argc)
+      {
+      	options.save_path = argv[++counter];
+      } else if(std::string(argv[counter]) == "--quantize" && counter + 1 < argc)
+      {
+      	options.bit_planes = atoi(argv[++counter]);
+      	if(options.bit_planes < 1 || options.bit_planes > 31)
+      	{
+      		std::cout << "--quantize must be between 1 and 31\n";
+      		return 1;
+      	}
+      } else if(std::string(argv[counter]) == "--schema" && counter + 1 < argc)
+      {
+      	options.schema = argv[++counter];
+      } else if(std::string(argv[counter]) == "--float")
+      {
+      	options.single_precision = true;
+      } else if(std::string(argv[counter]) == "--rescore-margin" && counter + 1 < argc)
+      {
+      	options.rescore_margin = atof(argv[++counter]);
+      } else if(std::string(argv[counter]) == "--lut-bins" && counter + 1 < argc)
+      {
+      	options.lut_bins = atoi(argv[++counter]);
+      	if(options.lut_bins < 2 || options.lut_bins > 65536)
+      	{
+      		std::cout << "--lut-bins must be between 2 and 65536\n";
+      		return 1;
+      	}
+      } else if(std::string(argv[counter]) == "--kde" && counter + 1 < argc)
+      {
+      	options.kde_grid = std::max(0, atoi(argv[++counter]));
+      } else if(std::string(argv[counter]) == "--tied-variance")
+      {
+      	options.tied_variance = true;
+      } else if(std::string(argv[counter]) == "--pca" && counter + 1 < argc)
+      {
+      	options.pca_components = std::max(0, atoi(argv[++counter]));
+      } else if(std::string(argv[counter]) == "--unlabeled" && counter + 1 < argc)
+      {
+      	options.unlabeled_path = argv[++counter];
+      	if(!valid_filepath(options.unlabeled_path))
+      	{
+      		std::cout << "Invalid filepath: " << options.unlabeled_path << "\n";
+      		return 1;
+      	}
+      } else if(std::string(argv[counter]) == "--em-tolerance" && counter + 1 < argc)
+      {
+      	options.em.tolerance = atof(argv[++counter]);
+      } else if(std::string(argv[counter]) == "--em-iterations" && counter + 1 < argc)
+      {
+      	options.em.max_iterations = std::max(1, atoi(argv[++counter]));
+      } else if(std::string(argv[counter]) == "--weight-column" && counter + 1 < argc)
+      {
+      	options.weight_column = std::max(0, atoi(argv[++counter]));
+      } else if(std::string(argv[counter]) == "--prune-classes")
+      {
+      	options.prune_classes = true;
+      } else if(std::string(argv[counter]) == "--top-classes" && counter + 1 < argc)
+      {
+      	options.top_classes = atoi(argv[++counter]);
+      } else if(std::string(argv[counter]) == "--probes" && counter + 1 < argc)
+      {
+      	options.probes = atoi(argv[++counter]);
+      } else if(std::string(argv[counter]) == "--hash-buckets" && counter + 1 < argc)
+      {
+      	options.hash_buckets = std::max(0L, atol(argv[++counter]));
+      } else if(std::string(argv[counter]) == "--discretize" && counter + 1 < argc)
+      {
+      	options.discretize_bins = std::max(0, atoi(argv[++counter]));
+      } else if(std::string(argv[counter]) == "--libsvm")
+      {
+      	options.libsvm = true;
+      } else if(std::string(argv[counter]) == "--load")
+      {
+      	options.load = true;
       } else
       {
         std::cout << "Unknown option argument: " << argv[counter] << "\n";
@@ -179,12 +1327,74 @@ int main(int argc, char ** argv)
     counter = counter + 1;
   }
 
-  if(gaussian || categorical)
+  if(!options.unlabeled_path.empty() && options.pca_components > 0)
+  {
+      std::cout << "--unlabeled cannot be combined with --pca\n";
+      return 1;
+  }
+
+  int gaussian_modes = (options.lut_bins > 0) + (options.kde_grid > 0) + !options.unlabeled_path.empty() + options.tied_variance + (options.top_classes > 0) + options.prune_classes + (options.rescore_margin >= 0);
+
+  if(gaussian_modes > 1)
+  {
+      std::cout << "--lut-bins, --kde, --unlabeled, --tied-variance, --top-classes, --prune-classes, and --rescore-margin cannot be combined\n";
+      return 1;
+  }
+
+  if(!options.save_path.empty() && (options.kde_grid > 0 || options.tied_variance || options.top_classes > 0 || options.prune_classes || options.rescore_margin >= 0 || options.single_precision || options.libsvm || options.multinomial || options.bernoulli || !options.schema.empty()))
+  {
+      std::cout << "--save applies to -g, -c, --lut-bins, and --unlabeled\n";
+      return 1;
+  }
+
+  if((options.hash_buckets > 0 || options.discretize_bins > 0) && (options.select || options.prune))
+  {
+      std::cout << "--hash-buckets and --discretize cannot be combined with -s, --top-k, or --min-score\n";
+      return 1;
+  }
+
+  if(options.libsvm && (options.load || !options.schema.empty() || options.bernoulli || !(options.gaussian || options.multinomial)))
+  {
+      std::cout << "--libsvm applies to -g and -m\n";
+      return 1;
+  }
+
+  if(options.weight_column > 0 && (options.single_precision || !options.schema.empty() || options.bernoulli || options.multinomial || options.libsvm || options.lut_bins > 0 || options.top_classes > 0 || options.prune_classes || options.rescore_margin >= 0 || !options.unlabeled_path.empty()))
+  {
+      std::cout << "--weight-column applies to -g, -c, --kde, and --tied-variance\n";
+      return 1;
+  }
+
+  if(options.weight_column > 0 && !options.load && options.weight_column >= csv_columns(argv[1]))
+  {
+      std::cout << "--weight-column " << options.weight_column << " is not a column of " << argv[1] << "\n";
+      return 1;
+  }
+
+  if(options.load)
+  {
+      model_driver(argv[2],argv[1],options);
+  } else if(!options.schema.empty())
+  {
+      mixed_driver(argv[2],argv[1],options);
+  } else if(options.bernoulli)
+  {
+      bernoulli_driver(argv[2],argv[1],options);
+  } else if(options.multinomial || (options.libsvm && options.gaussian))
+  {
+      sparse_driver(argv[2],argv[1],options);
+  } else if(options.categorical && !options.single_precision && codable(argv[1], options))
+  {
+      coded_driver(argv[2],argv[1],options);
+  } else if(options.single_precision && (options.gaussian || options.categorical))
+  {
+      float_driver(argv[2],argv[1],options);
+  } else if(options.gaussian || options.categorical)
   {
-      driver(argv[2],argv[1],verbose,gaussian,categorical);
+      driver(argv[2],argv[1],options);
   } else
   {
-  	printf("No classifier specificed. Please run with -g for gaussian or -c for categorical.\n");
+  	printf("No classifier specificed. Please run with -g for gaussian, -c for categorical, -m for multinomial, or -b for bernoulli.\n");
   }
 
   return 0;
@@ -0,0 +1,261 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <limits>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/nb_engine.h"
+#include "includes/mips_naive_bayes.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+const int query_block = 256; // queries scored per matrix product, bounds the scores buffer to query_block x classes
+
+Eigen::MatrixXd gaussian_inner_product_weights(const naive_bayes_engine<gaussian_distribution> & engine)
+{
+
+  /* Expands log P(y) + sum_j log N(x_j; mean, sd) into w_y with coefficients mean / sd^2 on x_j, -1 / (2 sd^2) on x_j^2, the rest of each feature's term on its observed indicator, and log P(y) on the constant 1. */
+
+  const feature_group<gaussian_distribution> & group = std::get<0>(engine.groups);
+  int k_size = group.columns.size();
+
+  Eigen::MatrixXd weights(engine.classes, 3 * k_size + 1);
+
+  for(int y = 0; y < engine.classes; y++)
+  {
+    for(int k = 0; k < k_size; k++)
+    {
+      const gaussian_distribution::parameters & p = group.parameters[y * k_size + k];
+      double precision = 1.0 / (p.standard_deviation * p.standard_deviation);
+
+      weights(y, k) = p.mean * precision;
+      weights(y, k_size + k) = -0.5 * precision;
+      weights(y, 2 * k_size + k) = -0.5 * p.mean * p.mean * precision - p.log_normalizer;
+    }
+
+    weights(y, 3 * k_size) = engine.log_priors[y];
+  }
+
+  return weights;
+}
+
+Eigen::MatrixXd augment_queries(const Eigen::MatrixXd & X, int size, const std::vector<int> & columns)
+{
+
+  /* Returns the rows [x, x^2, observed, 1] of the given columns of X. A missing (NaN) value is 0 in all three of its entries, so its whole term drops out of every inner product and it is marginalised out exactly. */
+
+  int k_size = columns.size();
+  Eigen::MatrixXd queries(size, 3 * k_size + 1);
+
+  for(int k = 0; k < k_size; k++)
+  {
+    Eigen::ArrayXd x = X.col(columns[k]).head(size);
+    Eigen::ArrayXd observed = (!x.isNaN()).cast<double>();
+    queries.col(k) = x.isNaN().select(0.0, x);
+    queries.col(k_size + k) = queries.col(k).array().square();
+    queries.col(2 * k_size + k) = observed;
+  }
+  queries.col(3 * k_size).setOnes();
+
+  return queries;
+}
+
+mips_index build_mips_index(const Eigen::MatrixXd & weights, int num_lists, int iterations)
+{
+
+  /* Clusters the classes into num_lists inverted lists with Lloyd's k-means over their means, where distances are computed for all classes against all centroids with one matrix product per iteration. A class can only score well for queries near its mean, so the lists nearest to a query hold its best classes. The means are recovered from w_y as mean_j = -(mean_j / sd_j^2) / (2 * -1 / (2 sd_j^2)). */
+
+  mips_index index;
+  index.weights = weights;
+
+  int classes = weights.rows();
+  int k_size = (weights.cols() - 1) / 3;
+  int dims = k_size;
+
+  Eigen::MatrixXd points = -0.5 * weights.leftCols(k_size).array() / weights.middleCols(k_size, k_size).array();
+  num_lists = std::max(1, std::min(num_lists, classes));
+
+  // evenly strided classes seed the centroids, so the index is deterministic
+
+  Eigen::MatrixXd centroids(num_lists, dims);
+  for(int l = 0; l < num_lists; l++)
+  {
+    centroids.row(l) = points.row((long) l * classes / num_lists);
+  }
+
+  std::vector<int> assignment(classes, -1);
+
+  for(int it = 0; it < iterations; it++)
+  {
+    // |p|^2 does not change which centroid is nearest to p, so it is left out of the distances
+
+    Eigen::MatrixXd distances = -2.0 * points * centroids.transpose();
+    distances.rowwise() += centroids.rowwise().squaredNorm().transpose();
+
+    bool changed = false;
+    for(int y = 0; y < classes; y++)
+    {
+      Eigen::Index l;
+      distances.row(y).minCoeff(&l);
+      changed |= (assignment[y] != l);
+      assignment[y] = l;
+    }
+
+    Eigen::MatrixXd sums = Eigen::MatrixXd::Zero(num_lists, dims);
+    std::vector<int> counts(num_lists, 0);
+    for(int y = 0; y < classes; y++)
+    {
+      sums.row(assignment[y]) += points.row(y);
+      counts[assignment[y]]++;
+    }
+
+    for(int l = 0; l < num_lists; l++)
+    {
+      if(counts[l] > 0)
+      {
+        centroids.row(l) = sums.row(l) / counts[l];
+      }
+    }
+
+    if(!changed)
+    {
+      break;
+    }
+  }
+
+  // a query [x, x^2, observed, 1] is nearest to the centroid maximizing [c, 0, 0, 0] . [x, x^2, observed, 1] - |c|^2 / 2
+
+  std::vector<std::vector<int>> lists(num_lists);
+  for(int y = 0; y < classes; y++)
+  {
+    lists[assignment[y]].push_back(y);
+  }
+
+  // centroids that lost all of their classes would only waste probes, so their lists are dropped
+
+  std::vector<int> kept;
+  for(int l = 0; l < num_lists; l++)
+  {
+    if(!lists[l].empty())
+    {
+      kept.push_back(l);
+    }
+  }
+
+  index.centroids = Eigen::MatrixXd::Zero(kept.size(), weights.cols());
+  index.offsets.resize(kept.size());
+  for(size_t l = 0; l < kept.size(); l++)
+  {
+    index.centroids.row(l).head(dims) = centroids.row(kept[l]);
+    index.offsets(l) = -0.5 * centroids.row(kept[l]).squaredNorm();
+    index.lists.push_back(lists[kept[l]]);
+  }
+
+  return index;
+}
+
+std::vector<int> top_k_of(const double * scores, const int * ids, int n, int k)
+{
+
+  /* Returns the ids of the k largest scores, best first. Ties favour the earlier id, as in a full argmax. */
+
+  std::vector<int> order(n);
+  for(int i = 0; i < n; i++)
+  {
+    order[i] = i;
+  }
+
+  auto better = [&](int a, int b) { return scores[a] > scores[b] || (scores[a] == scores[b] && ids[a] < ids[b]); };
+
+  k = std::min(k, n);
+  std::partial_sort(order.begin(), order.begin() + k, order.end(), better);
+
+  std::vector<int> top;
+  for(int i = 0; i < k; i++)
+  {
+    top.push_back(ids[order[i]]);
+  }
+
+  return top;
+}
+
+std::vector<std::vector<int>> mips_top_k(const mips_index & index, const Eigen::MatrixXd & queries, int k, int probes)
+{
+
+  /* Approximate top k classes of each query: only the classes in the probes lists nearest to the query are scored, and further lists are probed in order of distance until at least k classes have been scored. More probes trade speed for recall, probing every list is exact. */
+
+  int num_lists = index.lists.size();
+  probes = std::max(1, std::min(probes, num_lists));
+
+  std::vector<std::vector<int>> top;
+  std::vector<int> list_ids(num_lists);
+  std::vector<int> candidates;
+  std::vector<double> scores;
+  Eigen::RowVectorXd query;
+
+  for(int l = 0; l < num_lists; l++)
+  {
+    list_ids[l] = l;
+  }
+
+  // the queries are ranked against the list centroids with one matrix product per block of queries
+
+  for(int start = 0; start < queries.rows(); start += query_block)
+  {
+    int rows = std::min((int) queries.rows() - start, query_block);
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> list_scores = queries.middleRows(start, rows) * index.centroids.transpose();
+    list_scores.rowwise() += index.offsets.transpose();
+
+    for(int r = 0; r < rows; r++)
+    {
+      std::vector<int> ranked = top_k_of(list_scores.row(r).data(), list_ids.data(), num_lists, num_lists);
+
+      candidates.clear();
+      for(int i = 0; i < num_lists && (i < probes || (int) candidates.size() < k); i++)
+      {
+        const std::vector<int> & list = index.lists[ranked[i]];
+        candidates.insert(candidates.end(), list.begin(), list.end());
+      }
+
+      query = queries.row(start + r);
+      scores.resize(candidates.size());
+      for(size_t i = 0; i < candidates.size(); i++)
+      {
+        scores[i] = index.weights.row(candidates[i]).dot(query);
+      }
+
+      top.push_back(top_k_of(scores.data(), candidates.data(), candidates.size(), k));
+    }
+  }
+
+  return top;
+}
+
+std::vector<std::vector<int>> exhaustive_top_k(const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> & weights, const Eigen::MatrixXd & queries, int k)
+{
+
+  /* Exact top k classes of each query, scoring every class with one matrix product per block of queries. */
+
+  int classes = weights.rows();
+
+  std::vector<std::vector<int>> top;
+  std::vector<int> ids(classes);
+
+  for(int y = 0; y < classes; y++)
+  {
+    ids[y] = y;
+  }
+
+  for(int start = 0; start < queries.rows(); start += query_block)
+  {
+    int rows = std::min((int) queries.rows() - start, query_block);
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> scores = queries.middleRows(start, rows) * weights.transpose();
+
+    for(int r = 0; r < rows; r++)
+    {
+      top.push_back(top_k_of(scores.row(r).data(), ids.data(), classes, k));
+    }
+  }
+
+  return top;
+}
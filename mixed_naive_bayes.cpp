@@ -0,0 +1,79 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/mixed_naive_bayes.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+std::vector<column_type> parse_schema(const std::string & schema, bool & parsed)
+{
+
+  /* Parses a comma separated list of per-column distributions, g (Gaussian), c (categorical), b (Bernoulli), or i (ignored), one for each feature column. Schema may be given inline or as the path of a file holding the list. An unknown type is reported and parsed is set to false. */
+
+  std::string spec = schema;
+  std::ifstream in(schema);
+  parsed = true;
+
+  if(in)
+  {
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    spec = buffer.str();
+  }
+
+  std::vector<column_type> types;
+  std::stringstream lineStream(spec);
+  std::string cell;
+
+  while(std::getline(lineStream, cell, ','))
+  {
+    cell.erase(std::remove_if(cell.begin(), cell.end(), ::isspace), cell.end());
+
+    if(cell == "g")
+    {
+      types.push_back(GAUSSIAN_COLUMN);
+    } else if(cell == "c")
+    {
+      types.push_back(CATEGORICAL_COLUMN);
+    } else if(cell == "b")
+    {
+      types.push_back(BERNOULLI_COLUMN);
+    } else if(cell == "i")
+    {
+      types.push_back(IGNORED_COLUMN);
+    } else if(!cell.empty())
+    {
+      std::cout << "Unknown schema column type: " << cell << "\n";
+      parsed = false;
+      return types;
+    }
+  }
+
+  return types;
+}
+
+mixed_model fit_mixed(const Eigen::MatrixXd & training, const std::vector<int> & classifications, int classes, const std::vector<column_type> & schema, double alpha)
+{
+
+  /* Fits a mixed model on the engine, assigning every feature column to the group of its schema type, so all groups are fit in one pass over the training rows and scored by the same code as the single distribution models. */
+
+  mixed_model model;
+  model.distribution<1>().alpha = alpha;
+  model.distribution<2>().alpha = alpha;
+
+  for(size_t j = 0; j < schema.size(); j++)
+  {
+    if(schema[j] == GAUSSIAN_COLUMN) model.columns<0>().push_back(j + 1);
+    if(schema[j] == CATEGORICAL_COLUMN) model.columns<1>().push_back(j + 1);
+    if(schema[j] == BERNOULLI_COLUMN) model.columns<2>().push_back(j + 1);
+  }
+
+  model.fit(training, training.rows(), classifications, classes);
+
+  return model;
+}
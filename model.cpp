@@ -0,0 +1,542 @@
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <fstream>
+#include <cstdlib>
+#include <limits>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/lut_naive_bayes.h"
+#include "includes/label_dictionary.h"
+#include "includes/categorical_dataset.h"
+#include "includes/pca.h"
+#include "includes/nb_engine.h"
+#include "includes/naive_bayes.h"
+#include "includes/model.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+/* Models are saved as whitespace separated text, except for labels which take a line each: the model type, then the dataset columns the model was fit on (column 0 is the classification) and the original label of each class index, then the fitted parameters of each class. */
+
+void write_columns(std::ofstream & out, const std::vector<int> & columns)
+{
+
+  /* Writes the list of dataset columns a model scores. */
+
+  out << "columns " << columns.size();
+  for(auto v : columns)
+  {
+    out << " " << v;
+  }
+  out << "\n";
+}
+
+std::vector<int> read_columns(std::ifstream & in)
+{
+
+  /* Reads the list of dataset columns a model scores. */
+
+  std::string key;
+  size_t n = 0;
+  in >> key >> n;
+
+  std::vector<int> columns(n);
+  for(size_t i = 0; i < n; i++)
+  {
+    in >> columns[i];
+  }
+
+  return columns;
+}
+
+void write_labels(std::ofstream & out, const label_dictionary & dictionary, const std::string & key = "labels")
+{
+
+  /* Writes the original label of every class index, one per line, so labels may hold spaces. */
+
+  out << key << " " << dictionary.labels.size() << "\n";
+  for(auto & v : dictionary.labels)
+  {
+    out << v << "\n";
+  }
+}
+
+void read_label_lines(std::ifstream & in, size_t n, label_dictionary & dictionary)
+{
+
+  /* Reads the n labels following a key and count, adding them one at a time so they keep their saved indicies. */
+
+  in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+  for(size_t i = 0; i < n; i++)
+  {
+    std::string label;
+    std::getline(in, label);
+    encode_labels(dictionary, std::vector<std::string>(1, label));
+  }
+}
+
+void read_labels(std::ifstream & in, label_dictionary & dictionary)
+{
+
+  /* Reads the original label of every class index. */
+
+  std::string key;
+  size_t n = 0;
+  in >> key >> n;
+  read_label_lines(in, n, dictionary);
+}
+
+std::string model_type(const std::string & sys_path)
+{
+
+  /* Returns the type of a saved model, e.g. gaussian or categorical. */
+
+  std::ifstream in(sys_path);
+  std::string type;
+  in >> type;
+  return type;
+}
+
+double read_double(std::ifstream & in)
+{
+
+  /* Reads one number, including the -inf and nan that operator>> does not parse. */
+
+  std::string cell;
+  in >> cell;
+  return strtod(cell.c_str(), nullptr);
+}
+
+void write_pca(std::ofstream & out, const pca_projection * projection)
+{
+
+  /* Writes the PCA projection a model's features were taken through, when there is one. */
+
+  if(projection != nullptr)
+  {
+    out << "pca " << projection->components.rows() << " " << projection->components.cols() << "\n";
+    out << projection->mean << "\n";
+    out << projection->components << "\n";
+  }
+}
+
+void read_pca(std::ifstream & in, pca_projection & projection)
+{
+
+  /* Reads the PCA projection that follows a model's parameters, leaving projection empty when none was saved. */
+
+  std::string key;
+  int features = 0;
+  int components = 0;
+  if(in >> key && key == "pca" && in >> features >> components)
+  {
+    projection.mean.resize(features);
+    projection.components.resize(features, components);
+
+    for(int i = 0; i < features; i++)
+    {
+      in >> projection.mean(i);
+    }
+    for(int i = 0; i < features; i++)
+    {
+      for(int j = 0; j < components; j++)
+      {
+        in >> projection.components(i, j);
+      }
+    }
+  }
+}
+
+void save_gaussian_model(const std::string & sys_path, const naive_bayes_engine<gaussian_distribution> & engine, const std::vector<int> & columns, const label_dictionary & dictionary, const pca_projection * projection)
+{
+
+  /* Saves the fitted parameters of a Gaussian NB engine, the log prior and then the mean and standard deviation of every feature of each class, along with the dataset columns they were fit on, followed by the PCA projection of those columns when the engine was fit on its components. */
+
+  std::ofstream out(sys_path);
+  out.precision(17);
+
+  const feature_group<gaussian_distribution> & group = std::get<0>(engine.groups);
+  size_t k_size = group.columns.size();
+
+  out << "gaussian\n";
+  write_columns(out, columns);
+  write_labels(out, dictionary);
+  out << "classes " << engine.classes << " features " << k_size << "\n";
+
+  for(int y = 0; y < engine.classes; y++)
+  {
+    out << "class " << y << " " << engine.log_priors[y] << "\n";
+    for(size_t k = 0; k < k_size; k++)
+    {
+      const gaussian_distribution::parameters & p = group.parameters[y * k_size + k];
+      out << p.mean << " " << p.standard_deviation << "\n";
+    }
+  }
+
+  write_pca(out, projection);
+}
+
+naive_bayes_engine<gaussian_distribution> load_gaussian_model(const std::string & sys_path, std::vector<int> & columns, label_dictionary & dictionary, pca_projection & projection)
+{
+
+  /* Loads a Gaussian NB engine saved with save_gaussian_model, and its PCA projection when one was saved (otherwise projection is left empty). */
+
+  std::ifstream in(sys_path);
+  std::string key;
+  int classes = 0;
+  int k_size = 0;
+
+  in >> key;
+  columns = read_columns(in);
+  read_labels(in, dictionary);
+  in >> key >> classes >> key >> k_size;
+
+  Eigen::MatrixXd means(classes, k_size);
+  Eigen::MatrixXd standard_deviations(classes, k_size);
+  Eigen::VectorXd log_priors(classes);
+
+  for(int y = 0; y < classes; y++)
+  {
+    int classification = 0;
+    in >> key >> classification;
+    log_priors(y) = read_double(in);
+
+    for(int k = 0; k < k_size; k++)
+    {
+      means(y, k) = read_double(in);
+      standard_deviations(y, k) = read_double(in);
+    }
+  }
+
+  read_pca(in, projection);
+
+  return gaussian_engine_from_moments(means, standard_deviations, log_priors);
+}
+
+void save_categorical_model(const std::string & sys_path, const naive_bayes_engine<categorical_distribution> & engine, const std::vector<int> & columns, const label_dictionary & dictionary)
+{
+
+  /* Saves the fitted parameters of a Categorical NB engine, the log prior and then, for every feature of each class, the number of labels 0 .. the largest label it saw, the log probability shared by its unseen labels, and the log P(x_i = label | y) of each seen label, along with the dataset columns they were fit on. */
+
+  std::ofstream out(sys_path);
+  out.precision(17);
+
+  const feature_group<categorical_distribution> & group = std::get<0>(engine.groups);
+  size_t k_size = group.columns.size();
+
+  out << "categorical\n";
+  write_columns(out, columns);
+  write_labels(out, dictionary);
+  out << "classes " << engine.classes << " features " << k_size << "\n";
+
+  for(int y = 0; y < engine.classes; y++)
+  {
+    out << "class " << y << " " << engine.log_priors[y] << "\n";
+    for(size_t k = 0; k < k_size; k++)
+    {
+      const categorical_distribution::parameters & p = group.parameters[y * k_size + k];
+      out << p.labels << " " << p.log_unseen << " " << p.log_probabilities.size;
+      p.log_probabilities.for_each([&](uint32_t label, double v) { out << " " << label << " " << v; });
+      out << "\n";
+    }
+  }
+}
+
+naive_bayes_engine<categorical_distribution> load_categorical_model(const std::string & sys_path, std::vector<int> & columns, label_dictionary & dictionary)
+{
+
+  /* Loads a Categorical NB engine saved with save_categorical_model. */
+
+  std::ifstream in(sys_path);
+  naive_bayes_engine<categorical_distribution> engine;
+  feature_group<categorical_distribution> & group = std::get<0>(engine.groups);
+  std::string key;
+  int k_size = 0;
+
+  in >> key;
+  columns = read_columns(in);
+  read_labels(in, dictionary);
+  in >> key >> engine.classes >> key >> k_size;
+
+  for(int k = 0; k < k_size; k++)
+  {
+    group.columns.push_back(k + 1);
+  }
+
+  for(int y = 0; y < engine.classes; y++)
+  {
+    int classification = 0;
+    in >> key >> classification;
+    engine.log_priors.push_back(read_double(in));
+
+    for(int k = 0; k < k_size; k++)
+    {
+      categorical_distribution::parameters p;
+      size_t entries = 0;
+      in >> p.labels;
+      p.log_unseen = read_double(in);
+      in >> entries;
+
+      for(size_t i = 0; i < entries; i++)
+      {
+        uint32_t label = 0;
+        in >> label;
+        p.log_probabilities[label] = read_double(in);
+      }
+      group.parameters.push_back(p);
+    }
+  }
+
+  return engine;
+}
+
+void save_lut_model(const std::string & sys_path, const lut_model & model, const label_dictionary & dictionary, const pca_projection * projection)
+{
+
+  /* Saves a compiled lookup table model along with the dataset columns it was fit on, followed by the PCA projection of those columns when its features are their components. */
+
+  std::ofstream out(sys_path);
+  out.precision(17);
+
+  out << "lut\n";
+  write_columns(out, model.columns);
+  write_labels(out, dictionary);
+  out << "bins " << model.bins << " classes " << model.classes << " features " << model.edges.size() << " scale " << model.scale << "\n";
+
+  out << "biases";
+  for(auto v : model.biases)
+  {
+    out << " " << v;
+  }
+  out << "\n";
+
+  for(size_t k = 0; k < model.edges.size(); k++)
+  {
+    out << "feature " << k + 1 << "\n";
+    for(auto v : model.edges[k])
+    {
+      out << v << " ";
+    }
+    out << "\n";
+    for(int i = 0; i < model.bins * model.classes; i++)
+    {
+      out << model.tables[k * model.bins * model.classes + i] << " ";
+    }
+    out << "\n";
+  }
+
+  write_pca(out, projection);
+}
+
+lut_model load_lut_model(const std::string & sys_path, label_dictionary & dictionary, pca_projection & projection)
+{
+
+  /* Loads a compiled lookup table model saved with save_lut_model, and its PCA projection when one was saved (otherwise projection is left empty). */
+
+  std::ifstream in(sys_path);
+  lut_model model;
+  std::string key;
+  size_t k_size = 0;
+
+  in >> key;
+  model.columns = read_columns(in);
+  read_labels(in, dictionary);
+
+  in >> key >> model.bins >> key >> model.classes >> key >> k_size >> key >> model.scale;
+
+  in >> key;
+  model.biases.resize(model.classes);
+  for(int y = 0; y < model.classes; y++)
+  {
+    in >> model.biases[y];
+  }
+
+  for(size_t k = 0; k < k_size; k++)
+  {
+    int feature = 0;
+    in >> key >> feature;
+
+    std::vector<double> edges(model.bins - 1);
+    for(auto & v : edges)
+    {
+      in >> v;
+    }
+    model.edges.push_back(edges);
+
+    for(int i = 0; i < model.bins * model.classes; i++)
+    {
+      int v = 0;
+      in >> v;
+      model.tables.push_back((int16_t) v);
+    }
+  }
+
+  read_pca(in, projection);
+
+  return model;
+}
+
+void save_coded_categorical_model(const std::string & sys_path, const coded_categorical_model & model, const std::vector<column_codec> & codecs, const label_dictionary & dictionary, int weight_column)
+{
+
+  /* Saves Categorical NB fit on integer codes along with the codec of every feature, so new data is encoded with the same codes, and the csv column of the row weights (0 for none), so the test file is parsed with the same layout. */
+
+  std::ofstream out(sys_path);
+  out.precision(17);
+
+  std::vector<int> columns;
+  for(size_t j = 0; columns.size() <= model.features.size(); j++)
+  {
+    if((int) j != weight_column)
+    {
+      columns.push_back(j);
+    }
+  }
+
+  out << "coded_categorical\n";
+  write_columns(out, columns);
+  out << "weight_column " << weight_column << "\n";
+  write_labels(out, dictionary);
+  out << "classes " << model.classes << "\n";
+
+  out << "priors";
+  for(auto v : model.log_priors)
+  {
+    out << " " << v;
+  }
+  out << "\n";
+
+  for(size_t j = 0; j < model.features.size(); j++)
+  {
+    const coded_feature & feature = model.features[j];
+
+    out << "feature " << j + 1 << " " << feature.cardinality << " " << (feature.dense.empty() ? "sparse" : "dense") << "\n";
+
+    if(codecs[j].buckets > 0)
+    {
+      out << "hashed " << codecs[j].buckets << "\n";
+    } else if(!codecs[j].edges.empty())
+    {
+      out << "edges " << codecs[j].edges.size();
+      for(auto v : codecs[j].edges)
+      {
+        out << " " << v;
+      }
+      out << "\n";
+    } else if(codecs[j].raw)
+    {
+      out << "raw\n";
+    } else
+    {
+      write_labels(out, codecs[j].values, "values");
+    }
+
+    if(!feature.dense.empty())
+    {
+      for(auto v : feature.dense)
+      {
+        out << v << " ";
+      }
+      out << "\n";
+      continue;
+    }
+
+    for(int y = 0; y < model.classes; y++)
+    {
+      out << "class " << y << " " << feature.max_codes[y] << " " << feature.unseen[y] << " " << feature.sparse[y].size;
+      feature.sparse[y].for_each([&](uint32_t code, double v) { out << " " << code << " " << v; });
+      out << "\n";
+    }
+  }
+}
+
+coded_categorical_model load_coded_categorical_model(const std::string & sys_path, std::vector<column_codec> & codecs, label_dictionary & dictionary, int & weight_column)
+{
+
+  /* Loads Categorical NB, its feature codecs, and the csv column of its row weights saved with save_coded_categorical_model. */
+
+  std::ifstream in(sys_path);
+  coded_categorical_model model;
+  std::string key;
+
+  in >> key;
+  std::vector<int> columns = read_columns(in);
+  in >> key >> weight_column;
+  read_labels(in, dictionary);
+  in >> key >> model.classes;
+
+  in >> key;
+  model.log_priors.resize(model.classes);
+  for(auto & v : model.log_priors)
+  {
+    in >> v;
+  }
+
+  codecs.assign(columns.size() - 1, column_codec());
+
+  for(size_t j = 0; j + 1 < columns.size(); j++)
+  {
+    coded_feature feature;
+    int index = 0;
+    std::string layout;
+    in >> key >> index >> feature.cardinality >> layout;
+
+    // a dictionary encoded feature stores its values line, a raw one only the word raw, a hashed one its buckets, and a discretised one its bin edges
+
+    in >> key;
+    codecs[j].raw = (key == "raw");
+    if(key == "hashed")
+    {
+      in >> codecs[j].buckets;
+    } else if(key == "edges")
+    {
+      size_t n = 0;
+      in >> n;
+      codecs[j].edges.resize(n);
+      for(auto & v : codecs[j].edges)
+      {
+        in >> v;
+      }
+    } else if(key == "values")
+    {
+      size_t n = 0;
+      in >> n;
+      read_label_lines(in, n, codecs[j].values);
+    }
+
+    if(layout == "dense")
+    {
+      feature.dense.resize((size_t) (feature.cardinality + 1) * model.classes);
+      for(auto & v : feature.dense)
+      {
+        v = read_double(in);
+      }
+    } else
+    {
+      feature.sparse.resize(model.classes);
+      feature.max_codes.resize(model.classes);
+      feature.unseen.resize(model.classes);
+
+      for(int y = 0; y < model.classes; y++)
+      {
+        int classification = 0;
+        size_t entries = 0;
+        in >> key >> classification >> feature.max_codes[y];
+        feature.unseen[y] = read_double(in);
+        in >> entries;
+
+        for(size_t i = 0; i < entries; i++)
+        {
+          uint32_t code = 0;
+          in >> code;
+          feature.sparse[y][code] = read_double(in);
+        }
+      }
+    }
+
+    model.features.push_back(feature);
+  }
+
+  return model;
+}
@@ -7,355 +7,301 @@
 #include <cmath>
 #include "includes/eigen3/Eigen/Dense"
 #include "includes/utils.h"
+#include "includes/discrete_naive_bayes.h"
+#include "includes/nb_engine.h"
+#include "includes/fixed_naive_bayes.h"
+#include "includes/naive_bayes.h"
 
 /* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
 
-double magnitude(std::vector<double> vector)
+int verbose_vector_count = 0;
+
+template<typename Scalar> basic_naive_bayes_engine<Scalar, basic_gaussian_distribution<Scalar>> basic_fit_gaussian_engine(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> & training, int training_size, int length, const std::vector<Scalar> & weights = std::vector<Scalar>())
 {
-	/* Returns magnitude of given vector. */
-	
-	double sum = 0.0;
-	for(auto f : vector)
-	{
-		sum += (f * f);
-	}
-
-	return sqrt(sum);
+
+  /* Fits the Gaussian NB engine in the given precision on feature columns 1 .. length - 1 of training, with optional row weights. */
+
+  basic_naive_bayes_engine<Scalar, basic_gaussian_distribution<Scalar>> engine;
+
+  for(int i = 1; i < length; i++)
+  {
+    engine.template columns<0>().push_back(i);
+  }
+
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(training.col(0).head(training_size).template cast<double>(), classes);
+  engine.fit(training, training_size, classifications, classes.size(), weights);
+
+  return engine;
 }
 
-std::vector<double> normalize(std::vector<double> vector)
+template<typename Scalar> std::vector<int> basic_gaussian_engine_predict(const basic_naive_bayes_engine<Scalar, basic_gaussian_distribution<Scalar>> & engine, const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> & validation, int validation_size, bool verbose)
 {
-	/* Returns normalized version of given vector. */
-	
-	std::vector<double> ret;
-	
-	double divisor = magnitude(vector);
-
-	for(auto f : vector)
-	{
-		ret.push_back(f / divisor);
-	}
-
-	return ret;
-}
 
-int verbose_vector_count = 0;
+  /* Returns the predicted classification of each validation row under a fitted (or loaded) Gaussian NB engine. */
 
-int len(const Eigen::VectorXd& vector)
-{
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 1> Vector;
 
- /* Computes the length of an input vector. */
+  if(verbose == false)
+  {
+    // small models are scored with a fixed size kernel when their dimensions were precompiled
 
- int sum = 0;
+    const auto & group = std::get<0>(engine.groups);
+    int c = engine.classes;
+    int k = group.columns.size();
 
- for(auto v : vector)
- {
-   sum += 1;
- }
+    Matrix means(c, k);
+    Matrix standard_deviations(c, k);
+    Vector log_priors = Eigen::Map<const Vector>(engine.log_priors.data(), c);
 
- return sum;
-}
+    for(int y = 0; y < c; y++)
+    {
+      for(int j = 0; j < k; j++)
+      {
+        means(y, j) = group.parameters[y * k + j].mean;
+        standard_deviations(y, j) = group.parameters[y * k + j].standard_deviation;
+      }
+    }
 
-double mean(const Eigen::VectorXd& vector)
-{
+    std::vector<int> predictions;
+    if(fixed_gaussian_predict(means, standard_deviations, log_priors, validation, validation_size, predictions))
+    {
+      return predictions;
+    }
+
+    return engine.predict(validation, validation_size);
+  }
+
+  std::vector<int> predictions;
+  std::vector<Scalar> scores(engine.classes);
+
+  for(int i = 0; i < validation_size; i++)
+  {
+    Vector row = validation.row(i);
+
+    std::cout << "Row " << verbose_vector_count++ << ": [ ";
+    for(auto v : row)
+    {
+      std::cout << v << " ";
+    }
+    std::cout << "]\n";
 
- /* Computes the mean of an input vector. */
+    engine.log_posteriors(row, scores.data());
 
- return vector.mean();
+    for(size_t y = 0; y < scores.size(); y++)
+    {
+      std::cout << "Class: " << y << " Probability: " << exp(scores[y]) << "\n";
+    }
+    std::cout << "\n";
+
+    predictions.push_back(std::max_element(scores.begin(), scores.end()) - scores.begin());
+  }
+
+  return predictions;
 }
 
-double standard_deviation(const Eigen::VectorXd& vector)
+template<typename Scalar> std::vector<int> gaussian_engine_classifier(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> & validation, int validation_size, const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> & training, int training_size, int length, bool verbose, const std::vector<Scalar> & weights = std::vector<Scalar>())
 {
 
- /* Computes the standard deviation of an input vector. */
+  /* Fits the Gaussian NB engine in the given precision, with optional row weights, and returns the predicted classification of each validation row. */
 
- int size = len(vector)-1;
- double average = mean(vector);
- double standard_deviation = 0.0;
+  return basic_gaussian_engine_predict(basic_fit_gaussian_engine(training, training_size, length, weights), validation, validation_size, verbose);
+}
 
- for(auto v : vector)
- {
-   standard_deviation += pow((v-average), 2);
- }
+naive_bayes_engine<gaussian_distribution> fit_gaussian_engine(const Eigen::MatrixXd & training, int training_size, int length, const std::vector<double> & weights)
+{
 
- return sqrt((double) (standard_deviation / size));
+  /* Fits the double precision Gaussian NB engine, e.g. to be saved. */
+
+  return basic_fit_gaussian_engine<double>(training, training_size, length, weights);
 }
 
-double gaussian_pdf(double x, double mean, double standard_deviation)
+std::vector<int> gaussian_engine_predict(const naive_bayes_engine<gaussian_distribution> & engine, const Eigen::MatrixXd & validation, int validation_size, bool verbose)
 {
 
- /* Computes the Gaussian probability distribution function for x. */
+  /* Scores validation rows under a double precision Gaussian NB engine with the same kernels as a freshly fit model. */
 
- double exponent = exp(-pow((x-mean),2) / (2 * pow(standard_deviation,2)));
- return (1 / (sqrt(2 * M_PI) * standard_deviation)) * exponent;
+  return basic_gaussian_engine_predict<double>(engine, validation, validation_size, verbose);
 }
 
-int indicies_size = 0;
-
-std::vector<int> class_indicies(Eigen::MatrixXd X, int size)
+naive_bayes_engine<gaussian_distribution> gaussian_engine_from_moments(const Eigen::MatrixXd & means, const Eigen::MatrixXd & standard_deviations, const Eigen::VectorXd & log_priors)
 {
 
-  /* Returns a vector containing the indicies at which the classification (first row entry) changes in a sorted matrix. */
+  /* Builds a Gaussian NB engine over feature columns 1 .. k from the mean and standard deviation of each class (row) and feature (column), e.g. for a saved model. */
 
-  int idx = 0;
+  naive_bayes_engine<gaussian_distribution> engine;
+  feature_group<gaussian_distribution> & group = std::get<0>(engine.groups);
 
-  std::vector<int> indicies;
-  indicies.push_back(0);
+  engine.classes = means.rows();
+  engine.log_priors.assign(log_priors.data(), log_priors.data() + log_priors.size());
 
-  Eigen::VectorXd row = X.row(0);
-  int prev_classification = (int) get_eigen_index(row,0);
+  for(int k = 0; k < means.cols(); k++)
+  {
+    group.columns.push_back(k + 1);
+  }
 
-  for(int i = 1; i < size; i++)
+  for(int y = 0; y < means.rows(); y++)
   {
-    idx++;
-    Eigen::VectorXd row = X.row(i);
-    int classification = (int) get_eigen_index(row,0);
-    if(classification != prev_classification)
+    for(int k = 0; k < means.cols(); k++)
     {
-      indicies.push_back(idx);
+      group.parameters.push_back(group.distribution.from_moments(means(y, k), standard_deviations(y, k)));
     }
-    prev_classification = classification;
   }
 
-  indicies_size = size;
-
-  return indicies;
-
+  return engine;
 }
 
-std::vector<std::vector<double>> summarize_dataset(Eigen::MatrixXd dataset, int length)
+template<typename Scalar, typename Distribution> basic_naive_bayes_engine<Scalar, Distribution> fit_single_group(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> & training, int training_size, int length, Distribution distribution, const std::vector<Scalar> & weights = std::vector<Scalar>())
 {
 
-  /* Calculate the mean, standard deviation, and length of each column in input dataset. */
+  /* Fits an engine that models every feature column with one distribution, with optional row weights. */
 
-  std::vector<std::vector<double>> summary;
+  basic_naive_bayes_engine<Scalar, Distribution> engine;
+  engine.template distribution<0>() = distribution;
 
-  for(int i = 0; i < length; i++)
+  for(int i = 1; i < length; i++)
   {
+    engine.template columns<0>().push_back(i);
+  }
 
-    Eigen::VectorXd col = dataset.col(i);
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(training.col(0).head(training_size).template cast<double>(), classes);
+  engine.fit(training, training_size, classifications, classes.size(), weights);
 
-    std::vector<double> entry;
+  return engine;
+}
 
-    entry.push_back(mean(col));
-    entry.push_back(standard_deviation(col));
-    entry.push_back(len(col));
+template<typename Scalar, typename Distribution> std::vector<int> single_group_classifier(const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> & validation, int validation_size, const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> & training, int training_size, int length, Distribution distribution, const std::vector<Scalar> & weights = std::vector<Scalar>())
+{
 
-    summary.push_back(entry);
-  }
+  /* Fits an engine that models every feature column with one distribution, with optional row weights, and returns the predicted classification of each validation row. */
 
-  return summary;
+  return fit_single_group(training, training_size, length, distribution, weights).predict(validation, validation_size);
 }
 
-std::vector<Eigen::MatrixXd> matricies_by_classification(Eigen::MatrixXd dataset, int size, int length)
+naive_bayes_engine<categorical_distribution> fit_categorical_engine(const Eigen::MatrixXd & training, int training_size, int length, double alpha, const std::vector<double> & weights)
 {
 
-  /* Sorts dataset by classification and returns vector consisting of sub-matricies by classification. */
+  /* Fits the double precision Categorical NB engine with the given smoothing, e.g. to be saved. */
 
-  Eigen::MatrixXd sorted_dataset = sorted_rows_by_classification(dataset);
-  std::vector<int> indicies = class_indicies(sorted_dataset,size);
-  std::vector<Eigen::MatrixXd> ret;
+  categorical_distribution distribution;
+  distribution.alpha = alpha;
 
-  int indicies_array [indicies_size];
-  int idx = 0;
-  for(auto v : indicies) { 
-  	indicies_array[idx++] = v; 
-  }
-  int indicies_array_size = idx - 1;
-  idx = 1;
-  
-  std::vector<Eigen::VectorXd> rows;
-  bool check_final = false;
-  int i = 0;
-  while (i < size)
-  { 
-    if(check_final == false && i == indicies_array[idx]) 
-    {
-      Eigen::MatrixXd entry(rows.size(),length);
-      int j = 0;
-      for(auto v : rows)
-      {
-        entry.row(j) = v;
-        j++;
-      }
-      if(idx != indicies_array_size)
-      {
-      idx++;
-      } else
-      {
-        check_final = true;
-      }
-      ret.push_back(entry);
-      rows.clear();
-    }
+  return fit_single_group<double>(training, training_size, length, distribution, weights);
+}
 
-    Eigen::VectorXd row = sorted_dataset.row(i);
-    rows.push_back(row);
-    i++;
-  }
+std::vector<int> gaussian_rescored_classifier(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length, double margin, rescoring_counters & counters)
+{
 
+  /* Mixed precision Gaussian NB: every row is scored in float, rows whose top two classes are within margin in log space are rescored in double. */
 
-  Eigen::MatrixXd entry(rows.size(),length);
-  int j = 0;
-  for(auto v : rows)
+  basic_naive_bayes_engine<float, basic_gaussian_distribution<float>> fast;
+  naive_bayes_engine<gaussian_distribution> exact;
+
+  for(int i = 1; i < length; i++)
   {
-    entry.row(j) = v;
-    j++;
+    fast.columns<0>().push_back(i);
+    exact.columns<0>().push_back(i);
   }
-  ret.push_back(entry);
 
-  return ret;
-}
+  Eigen::MatrixXf training_float = training.cast<float>();
+  Eigen::MatrixXf validation_float = validation.cast<float>();
 
-int num_classifications = 0;
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(training.col(0).head(training_size), classes);
+  fast.fit(training_float, training_size, classifications, classes.size());
+  exact.fit(training, training_size, classifications, classes.size());
+
+  return predict_rescored(fast, exact, validation_float, validation, validation_size, margin, counters);
+}
 
-std::map<int, std::vector<std::vector<double>>> summarize_by_classification(Eigen::MatrixXd dataset, int size, int length)
+std::vector<int> gaussian_pruned_classifier(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length, pruning_counters & counters)
 {
 
-  /* Returns the mean, standard deviation, and length of each column for each sub-matrix sorted by class. */
+  /* Gaussian NB with exact branch and bound class pruning, for models with many classes. Features are accumulated in decreasing order of the prior weighted variance of their class means over their prior weighted mean class variance. */
 
-  std::vector<Eigen::MatrixXd> dict = matricies_by_classification(dataset, size, length);
-  std::map<int, std::vector<std::vector<double>>> ret;
+  naive_bayes_engine<gaussian_distribution> engine;
 
-  int classification = 0;
-  for( auto v : dict )
+  for(int i = 1; i < length; i++)
   {
-    std::vector<std::vector<double>> summary = summarize_dataset(v, length);
-    ret[classification] = summary;
-    classification++;
+    engine.columns<0>().push_back(i);
   }
 
-  return ret;
-}
-
-std::map<int, double> calculate_classification_probabilities(std::map<int, std::vector<std::vector<double>>> summaries, Eigen::VectorXd row, int size, bool verbose)
-{
+  std::vector<double> classes;
+  std::vector<int> classifications = class_indicies_by_label(training.col(0).head(training_size), classes);
+  engine.fit(training, training_size, classifications, classes.size());
 
-  /* Calculates the classification probabilities for a single vector with P(y | x_1, x_2, ..., x_n) = P(y) * P(x_1 | y) * P(x_2 | y) * ... * P(x_n | y). */
-  
-  std::map<int, double> probabilities;
-  std::map<int, std::vector<std::vector<double>>>::iterator it;
-  int classification_value = 0;
-
-  if(verbose == true)
-  {
-    std::cout << "Row " << verbose_vector_count++ << ": [ ";
-    for(auto v : row)
-    {
-      std::cout << v << " ";
-    }
-    std::cout << "]\n";
+  const feature_group<gaussian_distribution> & group = std::get<0>(engine.groups);
+  int k_size = length - 1;
 
-  }
+  std::vector<double> scores;
+  std::vector<int> order;
 
-  for(it=summaries.begin(); it != summaries.end(); ++it)
+  for(int k = 0; k < k_size; k++)
   {
+    double grand_mean = 0.0;
+    double within = 0.0;
 
-    std::vector<std::vector<double>> entry = it->second;
-    probabilities[classification_value] = double_vector_list_lookup(entry,0,2) / (size); // compute P(y)
-
-    for(int i = 1; i < row.size(); i++) // compute P(x_1 | y) * P(x_2 | y) * ... * P(x_n | y)
+    for(int y = 0; y < engine.classes; y++)
     {
-      double mean = double_vector_list_lookup(entry,i,0);
-      double standard_deviation = double_vector_list_lookup(entry,i,1);
-      double x = get_eigen_index(row,i);
-      probabilities[classification_value] *= gaussian_pdf(x,mean,standard_deviation); 
+      const gaussian_distribution::parameters & p = group.parameters[y * k_size + k];
+      grand_mean += exp(engine.log_priors[y]) * p.mean;
+      within += exp(engine.log_priors[y]) * p.standard_deviation * p.standard_deviation;
     }
 
-    if(verbose == true)
+    double between = 0.0;
+
+    for(int y = 0; y < engine.classes; y++)
     {
-      std::cout << "Class: " << classification_value << " Probability: " << probabilities[classification_value] << "\n";
+      double d = group.parameters[y * k_size + k].mean - grand_mean;
+      between += exp(engine.log_priors[y]) * d * d;
     }
 
-    classification_value++;
+    scores.push_back(within > 0 ? between / within : 0.0);
+    order.push_back(k);
   }
 
-  if(verbose == true)
-  {
-    std::cout << "\n";
-  }
+  std::stable_sort(order.begin(), order.end(), [&scores](int a, int b) { return scores[a] > scores[b]; });
 
-  return probabilities;
+  return predict_pruned(engine, order, validation, validation_size, counters);
 }
 
-int predict(std::map<int, std::vector<std::vector<double>>> summaries, Eigen::VectorXd row, int size, bool verbose)
+std::vector<int> gaussian_naive_bayes_classifier(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length, bool verbose)
 {
 
-  /* Returns argmax classification prediction for Gaussian NB. */
-
-  std::map<int, double> probabilities = calculate_classification_probabilities(summaries, row, size, verbose);
-  std::map<int, double>::iterator it;
-
-  int best_label = -1;
-  double best_probability = -1;
-
-  for(it=probabilities.begin(); it != probabilities.end(); ++it)
-  {
-    if(best_label == -1 || it->second > best_probability)
-    {
-      best_probability = it->second;
-      best_label = it->first;
-    }
-  }
+  /* Calculates the classification probabilities for each row in dataset and puts their predicted classification in a list. */
 
-  return best_label; 
+  return gaussian_engine_classifier<double>(validation, validation_size, training, training_size, length, verbose);
 }
 
-int get_max_feature_label(Eigen::VectorXd col)
+std::vector<int> gaussian_naive_bayes_classifier(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length, bool verbose, const std::vector<double> & weights)
 {
-	/* Returns the maximum feature label from a column */
-
-	int max = 0;
 
-	for(auto v : col)
-	{
-		if(v > max)
-		{
-			max = v;
-		}
-	}
+  /* Gaussian NB fit with a weight per training row, where a row of weight w counts as w copies of it. */
 
-	return max;
+  return gaussian_engine_classifier<double>(validation, validation_size, training, training_size, length, verbose, weights);
 }
 
-int get_argmax(std::vector<double> probabilities,int len)
+std::vector<int> gaussian_naive_bayes_classifier(Eigen::MatrixXf validation, int validation_size, Eigen::MatrixXf training, int training_size, int length, bool verbose)
 {
 
-	/* Returns the argmax for probabilities i.e. the index of the largest probability for Categorical NB. */
+  /* Single precision Gaussian NB: data, fitted parameters, and scores are all float. */
 
-	int max_idx = 0;
-	double max_prob = probabilities[0];
-
-	for(int i = 0; i < len; i++)
-	{
-		if(probabilities[i] > max_prob)
-		{
-			max_prob = probabilities[i];
-			max_idx = i;
-		}
-	}
-
-	return max_idx;
+  return gaussian_engine_classifier<float>(validation, validation_size, training, training_size, length, verbose);
 }
 
-std::vector<int> gaussian_naive_bayes_classifier(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length, bool verbose)
+std::vector<int> kde_naive_bayes_classifier(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length, int grid, const std::vector<double> & weights)
 {
 
-  /* Calculates the classification probabilities for each row in dataset and puts their predicted classification in a list. */
+  /* Kernel density NB: each feature within each class is modelled by a kernel density estimate tabulated on grid points, for features that are multimodal or far from Gaussian. */
 
-  std::map<int, std::vector<std::vector<double>>> summaries = summarize_by_classification(training, training_size, length);
-  std::vector<int> predictions;
+  kde_distribution distribution;
+  distribution.grid = grid;
 
-  for(int i = 0; i < validation_size; i++)
-  {
-    int output = predict(summaries, validation.row(i), training_size, verbose);
-    predictions.push_back(output);
-  }
-
-  return predictions;
+  return single_group_classifier<double>(validation, validation_size, training, training_size, length, distribution, weights);
 }
 
-
 std::vector<int> categorical_naive_bayes_classifier(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length, bool verbose)
 {
 
@@ -368,129 +314,34 @@ std::vector<int> categorical_naive_bayes_classifier(Eigen::MatrixXd validation,
   	printf("mode 2: categorical\n");
   }
 
-  std::vector<int> predictions;
+  categorical_distribution distribution;
+  distribution.alpha = alpha;
 
-  // calculate class frequencies, then
-  // calculate overall classification probabilities i.e. compute P(y)
+  return single_group_classifier<double>(validation, validation_size, training, training_size, length, distribution);
+}
 
-  std::vector<Eigen::MatrixXd> class_matricies_list = matricies_by_classification(training, training_size, length);
+std::vector<int> categorical_naive_bayes_classifier(Eigen::MatrixXd validation, int validation_size, Eigen::MatrixXd training, int training_size, int length, bool verbose, const std::vector<double> & weights)
+{
 
-  std::vector<int> unique_classifications;
-  std::vector<double> unique_classifications_count; 
-  std::vector<double> unique_classifications_probabilities;
-  
-  int c = 0;
-  
-  for(auto v : class_matricies_list)
-  {
-  	unique_classifications.push_back(c++);
-  }
-  
-  double total_count = 0.0;
+  /* Categorical NB fit with a weight per training row. */
 
-  for(int i = 0; i < c; i++)
-  {
-	double class_count = (double) class_matricies_list[i].rows();
-	unique_classifications_count.push_back(class_count);
-	total_count += class_count;
-  }		
-
-  for(auto v : unique_classifications_count)
+  if(verbose)
   {
-  	double unique_classification_probability = 0.0;
-	unique_classification_probability =  (double)v /(double)total_count;
-  	unique_classifications_probabilities.push_back(unique_classification_probability);
+  	printf("mode 2: categorical\n");
   }
 
-  // record the features of each vector corresponding to classification
-
-  std::vector<Eigen::MatrixXd> list = matricies_by_classification(training, training_size, length);
-
-  std::map<int,std::vector<std::map<int,double>>> dict;
-
-  int current_class = 0;
-
-  for(auto class_matrix : list)
-  {
-  	
-	// each iteration corresponds to one classifications individual matrix
-
-  	std::vector<std::map<int,double>> entry; 
-	
-	for(int i = 1; i < class_matrix.cols(); i++)
-	{
-
-		std::map<int,double> col_labels;
-
-		Eigen::VectorXd feature_column = class_matrix.col(i);
-
-		int max_label = get_max_feature_label(feature_column);
-		int label_counts [max_label];
-
-		int curr_len = 0;
-		for(int j = 0; j <= max_label; j++)
-		{
-			label_counts[j] = 0;
-			curr_len++;
-		}
-				
-		int feature_column_length = len(feature_column);
-
-		for(int j = 0; j < feature_column_length; j++)
-		{
-			int label = feature_column[j];
-			label_counts[label] += 1;
-		}
-
-		for(int j = 1; j < max_label+1; j++)
-		{
-			// computes P(x_i | y) while utilizing laplace smoothing
-
-			col_labels[j] = (double) ((label_counts[j] + alpha) / (feature_column_length + alpha * class_matrix.rows())); 
-		}
-
-		entry.push_back(col_labels);
-	}
+  return single_group_classifier<double>(validation, validation_size, training, training_size, length, categorical_distribution(), weights);
+}
 
-  	dict[current_class++] = entry;
-  }
-  
-  int mat_num = 0;
+std::vector<int> categorical_naive_bayes_classifier(Eigen::MatrixXf validation, int validation_size, Eigen::MatrixXf training, int training_size, int length, bool verbose)
+{
 
-  // now we can lookup: dict[y][x_n][feature] = P(x_i | y)
-  // now compute the probability of each input vector belonging to a classification 
+  /* Single precision Categorical NB. */
 
-  for(int i = 0; i < validation_size; i++)
+  if(verbose)
   {
-  	Eigen::VectorXd row = validation.row(i);
-
-	std::vector<double> probabilities;
-	
-	for(int j = 0; j < c; j++)
-	{
-		double p_y = unique_classifications_probabilities[j];
-		
-		double p_yx = p_y;
-
-		for(int k = 1; k < len(row); k++)
-		{
-			int label = row[k];
-			
-			double p_xy = dict[j][k-1][label];
-			p_yx *= p_xy; 
-		}
-		
-		probabilities.push_back(p_yx);
-	}
-
-	std::vector<double> normalized_probabilities = normalize(probabilities); 
-
- 	 // assign classification using argmax probability
-  
-	int pred = get_argmax(normalized_probabilities,c);
-	predictions.push_back(pred);
-
+  	printf("mode 2: categorical\n");
   }
 
-  return predictions;
+  return single_group_classifier<float>(validation, validation_size, training, training_size, length, basic_categorical_distribution<float>());
 }
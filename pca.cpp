@@ -0,0 +1,116 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <random>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/pca.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+const int pca_block = 256; // rows projected per matrix product
+const int wide_features = 512; // above this many features the components are found with a randomized range finder
+const int oversampling = 10; // extra random directions sampled by the range finder
+const int power_iterations = 2; // sharpen the range finder's spectrum for slowly decaying variances
+
+Eigen::MatrixXd thin_q(const Eigen::MatrixXd & Y)
+{
+
+  /* Returns an orthonormal basis for the columns of Y. */
+
+  Eigen::HouseholderQR<Eigen::MatrixXd> qr(Y);
+  return qr.householderQ() * Eigen::MatrixXd::Identity(Y.rows(), Y.cols());
+}
+
+pca_projection fit_pca(const Eigen::MatrixXd & training, int training_size, int length, int k)
+{
+
+  /* Fits a whitening projection onto the top k principal components of feature columns 1 .. length - 1 of training. */
+
+  int k_size = length - 1;
+  k = std::max(1, std::min(k, k_size));
+
+  pca_projection projection;
+
+  Eigen::MatrixXd X = training.block(0, 1, training_size, k_size);
+  Eigen::ArrayXXd observed = (X.array() == X.array()).cast<double>();
+  Eigen::MatrixXd filled = (observed > 0).select(X.array(), 0.0).matrix();
+
+  projection.mean = filled.colwise().sum().array() / observed.colwise().sum().max(1.0);
+  X = (observed > 0).select(filled.array().rowwise() - projection.mean.array(), 0.0).matrix();
+
+  Eigen::MatrixXd directions;
+  Eigen::VectorXd variances;
+  double dof = std::max(1, training_size - 1);
+
+  if(k_size <= wide_features)
+  {
+    // eigenvalues come out in increasing order, so the top k are the last k reversed
+
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver((X.transpose() * X) / dof);
+    directions = solver.eigenvectors().rightCols(k).rowwise().reverse();
+    variances = solver.eigenvalues().tail(k).reverse();
+  } else
+  {
+    // randomized range finder: project onto a few random directions, refine with power iterations, and take the SVD of the small projected matrix
+
+    int l = std::min(k_size, k + oversampling);
+
+    std::mt19937 generator(1);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    Eigen::MatrixXd omega(k_size, l);
+    for(int j = 0; j < l; j++)
+    {
+      for(int i = 0; i < k_size; i++)
+      {
+        omega(i, j) = normal(generator);
+      }
+    }
+
+    Eigen::MatrixXd Q = thin_q(X * omega);
+    for(int i = 0; i < power_iterations; i++)
+    {
+      Q = thin_q(X * thin_q(X.transpose() * Q));
+    }
+
+    Eigen::MatrixXd B = Q.transpose() * X;
+    Eigen::JacobiSVD<Eigen::MatrixXd> svd(B, Eigen::ComputeThinV);
+    directions = svd.matrixV().leftCols(k);
+    variances = svd.singularValues().head(k).array().square() / dof;
+  }
+
+  // components with (numerically) zero variance are left unscaled rather than blown up
+
+  double floor = 1e-12 * std::max(variances.maxCoeff(), 1e-300);
+  projection.variances = variances;
+  projection.components = directions * (variances.array().max(floor).rsqrt()).matrix().asDiagonal();
+
+  return projection;
+}
+
+Eigen::MatrixXd apply_pca(const pca_projection & projection, const Eigen::MatrixXd & X, int size)
+{
+
+  /* Returns the classification column of X followed by its whitened principal component scores, projecting pca_block rows per matrix product. */
+
+  int k_size = projection.mean.size();
+  int k = projection.components.cols();
+
+  Eigen::MatrixXd projected(size, k + 1);
+  projected.col(0) = X.col(0).head(size);
+
+  for(int start = 0; start < size; start += pca_block)
+  {
+    int rows = std::min(size - start, pca_block);
+    Eigen::MatrixXd block = X.block(start, 1, rows, k_size).rowwise() - projection.mean;
+
+    if(block.hasNaN())
+    {
+      block = (block.array() == block.array()).select(block, 0.0);
+    }
+
+    projected.block(start, 1, rows, k).noalias() = block * projection.components;
+  }
+
+  return projected;
+}
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "includes/quantile_sketch.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+void quantile_sketch::add(double x)
+{
+
+  /* Adds one value, compressing once the buffer holds four times the capacity. */
+
+  buffer.push_back(x);
+  total += 1;
+
+  if(buffer.size() >= 4 * capacity)
+  {
+    compress();
+  }
+}
+
+void quantile_sketch::compress()
+{
+
+  /* Merges the buffered values into the centroids in one sorted pass. */
+
+  if(buffer.empty())
+  {
+    return;
+  }
+
+  std::vector<std::pair<double, double>> points;
+  for(size_t i = 0; i < means.size(); i++)
+  {
+    points.push_back(std::make_pair(means[i], weights[i]));
+  }
+  for(auto v : buffer)
+  {
+    points.push_back(std::make_pair(v, 1.0));
+  }
+  buffer.clear();
+
+  std::sort(points.begin(), points.end());
+
+  double limit = std::max(1.0, total / capacity);
+
+  means.clear();
+  weights.clear();
+
+  for(auto & p : points)
+  {
+    if(!weights.empty() && weights.back() + p.second <= limit)
+    {
+      double w = weights.back() + p.second;
+      means.back() += (p.first - means.back()) * p.second / w;
+      weights.back() = w;
+    } else
+    {
+      means.push_back(p.first);
+      weights.push_back(p.second);
+    }
+  }
+}
+
+double quantile_sketch::quantile(double q)
+{
+
+  /* Returns the value at rank q * total, interpolating between the centres of adjacent centroids. */
+
+  compress();
+
+  if(means.empty())
+  {
+    return 0.0;
+  }
+
+  double target = q * total;
+  double cumulative = 0.0;
+
+  for(size_t i = 0; i < means.size(); i++)
+  {
+    double centre = cumulative + weights[i] / 2;
+
+    if(target < centre)
+    {
+      if(i == 0)
+      {
+        return means[0];
+      }
+
+      double previous = cumulative - weights[i - 1] / 2;
+      return means[i - 1] + (means[i] - means[i - 1]) * (target - previous) / (centre - previous);
+    }
+
+    cumulative += weights[i];
+  }
+
+  return means.back();
+}
+
+std::vector<double> equal_frequency_edges(quantile_sketch & sketch, int bins)
+{
+
+  /* Returns the bins - 1 edges at the 1 / bins, 2 / bins, .. quantiles of the sketch, without repeats, so value x falls in bin upper_bound(edges, x). Heavily tied values give fewer bins. */
+
+  std::vector<double> edges;
+
+  for(int b = 1; b < bins; b++)
+  {
+    double edge = sketch.quantile((double) b / bins);
+    if(edges.empty() || edge > edges.back())
+    {
+      edges.push_back(edge);
+    }
+  }
+
+  return edges;
+}
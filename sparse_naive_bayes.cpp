@@ -0,0 +1,62 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include "includes/eigen3/Eigen/Dense"
+#include "includes/eigen3/Eigen/SparseCore"
+#include "includes/discrete_naive_bayes.h"
+#include "includes/sparse_naive_bayes.h"
+
+/* Nathan Englehart, Xuhang Cao, Samuel Topper, Ishaq Kothari (Autumn 2021) */
+
+sparse_gaussian_model fit_sparse_gaussian(const SparseMatrixXd & X, const std::vector<int> & classifications, int classes, double var_smoothing)
+{
+
+  /* Fits Gaussian NB on sparse rows, where every missing cell is a zero, in a single pass over the nonzeros. Features that are constant within a class (typically all zero) have no variance, so var_smoothing times the largest feature variance is added to every variance as in scikit-learn. */
+
+  Eigen::VectorXd class_counts = Eigen::VectorXd::Zero(classes);
+  Eigen::MatrixXd sums = Eigen::MatrixXd::Zero(X.cols(), classes);
+  Eigen::MatrixXd squares = Eigen::MatrixXd::Zero(X.cols(), classes);
+
+  for(int r = 0; r < X.outerSize(); r++)
+  {
+    int y = classifications[r];
+    class_counts(y) += 1;
+
+    for(SparseMatrixXd::InnerIterator it(X, r); it; ++it)
+    {
+      sums(it.col(), y) += it.value();
+      squares(it.col(), y) += it.value() * it.value();
+    }
+  }
+
+  Eigen::MatrixXd means = sums.array().rowwise() / class_counts.transpose().array();
+
+  // sample variance over all n rows of the class, zeros included
+
+  Eigen::MatrixXd variances = (squares.array() - means.array().square().rowwise() * class_counts.transpose().array()).rowwise() / (class_counts.transpose().array() - 1).max(1.0);
+  variances = variances.array().max(0.0);
+  variances.array() += var_smoothing * std::max(variances.maxCoeff(), 1e-300);
+
+  sparse_gaussian_model model;
+  model.linear = means.array() / variances.array();
+  model.quadratic = -0.5 / variances.array();
+
+  model.baselines = (class_counts.array() / X.rows()).log().transpose();
+  model.baselines -= (0.5 * (2 * M_PI * variances.array()).log() + 0.5 * means.array().square() / variances.array()).colwise().sum().matrix();
+
+  return model;
+}
+
+Eigen::MatrixXd sparse_gaussian_scores(const sparse_gaussian_model & model, const SparseMatrixXd & X)
+{
+
+  /* Returns the (rows x classes) Gaussian NB log posteriors. Each row starts from the all zero baseline and only its nonzeros add their change in log likelihood, so the cost scales with the nonzeros rather than the columns. */
+
+  SparseMatrixXd X_squared = X.cwiseProduct(X);
+
+  Eigen::MatrixXd scores = X * model.linear + X_squared * model.quadratic;
+  scores.rowwise() += model.baselines;
+
+  return scores;
+}